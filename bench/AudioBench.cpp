@@ -0,0 +1,91 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "AudioSystem.hpp"
+
+// Mide el coste de mezcla del AudioSystem sin tarjeta de sonido (modo offline).
+// Uso: AudioBench [segundos por prueba]
+int main(int argc, char** argv)
+{
+    constexpr unsigned MaxVoices = 256;
+    constexpr uint64_t Block = 512;
+
+    double seconds = argc > 1 ? std::atof(argv[1]) : 5.0;
+    if(seconds <= 0.0)
+        seconds = 5.0;
+
+    AudioSettings settings;
+    settings.offline = true;
+    settings.max_voices = MaxVoices;
+
+    auto& audio = AudioSystem::Get();
+    if(!audio.init(settings))
+        return EXIT_FAILURE;
+
+    // Un segundo de seno como clip de prueba
+    unsigned channels = audio.getChannels();
+    unsigned rate = audio.getSampleRate();
+
+    std::vector<float> tone(size_t(rate) * channels);
+    for(unsigned i = 0; i < rate; i++)
+        for(unsigned c = 0; c < channels; c++)
+            tone[size_t(i) * channels + c] = 0.25f * std::sin(2.f * 3.14159265f * 440.f * float(i) / float(rate));
+
+    auto clip = audio.addAudio("bench_tone", tone);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coord(-10.f, 10.f);
+
+    std::cout << "voces\tus/bloque\tus/voz\tx tiempo real" << std::endl;
+
+    for(unsigned count : {1u, 8u, 16u, 32u, 64u, 128u, 256u})
+    {
+        std::vector<AudioSystem::Voice> voices;
+        for(unsigned i = 0; i < count; i++)
+        {
+            VoiceParams params;
+            params.loop = true;
+            params.position = {coord(rng), coord(rng), coord(rng)};
+            params.max_distance = 100.f;  // Todas audibles: se mide la mezcla, no la virtualización
+            voices.push_back(audio.play(clip, params));
+        }
+
+        // Los Stop de la prueba anterior y los Start de ésta pueden no caber en la
+        // cola de una vez: se vacía antes de medir para mezclar exactamente count voces
+        do
+            audio.update(0.f);
+        while(audio.hasPendingCommands());
+
+        if(audio.getActiveVoices() != count)
+        {
+            std::cerr << "[AudioBench] " << audio.getActiveVoices() << " voces activas, se esperaban " << count << std::endl;
+            audio.shutdown();
+            return EXIT_FAILURE;
+        }
+
+        uint64_t total = uint64_t(seconds * rate);
+        uint64_t blocks = total / Block;
+
+        auto start = std::chrono::steady_clock::now();
+        for(uint64_t b = 0; b < blocks; b++)
+            audio.mix(Block);
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        double per_block = elapsed / double(blocks);
+        double block_time = 1e6 * double(Block) / double(rate);
+
+        std::cout << count << "\t" << per_block << "\t" << per_block / count
+                  << "\t" << block_time / per_block << std::endl;
+
+        for(auto voice : voices)
+            audio.stop(voice);
+        audio.update(0.f);
+    }
+
+    audio.shutdown();
+    return EXIT_SUCCESS;
+}
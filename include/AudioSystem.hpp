@@ -0,0 +1,189 @@
+#ifndef AUDIO_SYSTEM_HPP
+#define AUDIO_SYSTEM_HPP
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Forward declaration de miniaudio para no ensuciar el header
+struct ma_engine;
+
+
+struct AudioSettings
+{
+    unsigned max_voices = 32;       // Voces simultáneas, se reservan todas en init()
+    float audibility_threshold = 0.01f; // Ganancia mínima para mezclar una voz espacial
+
+    // Sin dispositivo: update() mezcla en memoria a sample_rate (CI, servidores, benchmarks)
+    bool offline = false;
+    unsigned sample_rate = 48000;
+    unsigned channels = 2;
+};
+
+struct VoiceParams
+{
+    float volume = 1.f;
+    bool loop = false;
+    int priority = 0;               // Una voz sólo roba a otra de prioridad menor o igual
+    bool spatial = true;
+    glm::vec3 position{0.f, 0.f, 0.f};
+    float min_distance = 1.f;
+    float max_distance = 20.f;
+};
+
+/**
+ * Audio del juego sobre miniaudio.
+ *
+ * Cada fichero se decodifica una sola vez a PCM en el formato del motor y se
+ * comparte (shared_ptr) entre todas las voces que lo reproducen. Las voces salen
+ * de un pool fijo reservado en init(): cuando no queda ninguna libre se roba la
+ * de menor prioridad (y entre iguales la más antigua), así que memoria y coste de
+ * mezcla están acotados por max_voices.
+ *
+ * Los clips en streaming no se decodifican en addAudio(): la voz abre el fichero
+ * con MA_SOUND_FLAG_STREAM y el resource manager de miniaudio lo decodifica de
+ * forma asíncrona en páginas pequeñas, así que sólo queda residente ese buffer.
+ *
+ * Las voces espaciales fuera de max_distance del oyente, o con ganancia estimada
+ * por debajo de audibility_threshold, pasan a ser virtuales: se paran pero su
+ * cursor sigue avanzando, y al volver a oírse continúan donde tocaría. El coste
+ * de mezcla depende así de las voces audibles, no de las creadas.
+ *
+ * Las voces sólo cambian de estado en el hilo de audio: los cambios del hilo de
+ * juego se acumulan durante el frame y update() los envía como un lote por una
+ * cola lock-free (descartando posición y volumen si no han cambiado). El hilo
+ * de audio aplica el lote entre una mezcla y la siguiente, y es también quien
+ * lee el cursor de una voz al virtualizarla. El hilo de juego sólo consulta si
+ * una voz ha terminado (banderas atómicas de miniaudio) y crea y destruye el
+ * ma_sound de cada stream, que miniaudio no permite hacer desde el hilo de
+ * audio; abrir y decodificar el fichero ocurre en el hilo del resource manager.
+ *
+ * En modo offline no se abre ningún dispositivo: update(dt) aplica los comandos
+ * y mezcla dt segundos de audio en un buffer interno desde el propio bucle de
+ * juego, así que se puede ejecutar y medir sin tarjeta de sonido.
+ */
+class AudioSystem
+{
+    public:
+    using Clip = size_t;
+    static constexpr Clip InvalidClip = static_cast<Clip>(-1);
+
+    // Handle de una reproducción, deja de ser válido cuando la voz se recicla
+    struct Voice
+    {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+
+        bool valid() const { return index != UINT32_MAX; }
+    };
+
+    static AudioSystem& Get();
+
+    bool init(const AudioSettings& settings = {});
+    void shutdown();
+    bool isInitialized() const { return m_engine != nullptr; }
+    bool isOffline() const { return m_settings.offline; }
+
+    // Recicla las voces que han terminado, virtualiza las que no se oyen y envía
+    // los comandos del frame al hilo de audio. Una vez por frame.
+    void update(float dt);
+
+    // Decodifica el fichero (relativo a AUDIOS_PATH) si no estaba ya cargado.
+    // Con streaming no se decodifica entero: se lee por páginas mientras suena,
+    // pensado para música y ambientes largos.
+    Clip addAudio(const std::string& filename, bool streaming = false);
+
+    // Registra PCM ya generado (float entrelazado con los canales del motor)
+    Clip addAudio(const std::string& name, const std::vector<float>& frames);
+
+    // Suelta la referencia del banco, las voces que lo usan siguen sonando
+    void clearAudio(Clip clip);
+
+    Voice play(Clip clip, const VoiceParams& params = {});
+    void stop(Voice voice);
+    bool isPlaying(Voice voice) const;
+
+    void setPosition(Voice voice, const glm::vec3& pos);
+    void setVolume(Voice voice, float volume);
+
+    void setListenerPosition(const glm::vec3& pos);
+    void setListenerDirection(const glm::vec3& forward);
+
+    // Sólo en modo offline: aplica los comandos pendientes y mezcla frames en memoria
+    void mix(uint64_t frames);
+
+    unsigned getChannels() const;
+    unsigned getSampleRate() const;
+
+    unsigned getActiveVoices() const;
+    unsigned getAudibleVoices() const;
+
+    // Comandos enviados o por enviar que el hilo de audio aún no ha aplicado
+    bool hasPendingCommands() const;
+
+    // PCM decodificado en RAM (los clips en streaming no cuentan)
+    size_t getResidentBytes() const;
+
+    private:
+    static constexpr uint64_t MixBlock = 512;   // Frames por lectura en modo offline
+
+    struct AudioClip;
+    struct VoiceSlot;
+    struct Command;
+    struct CommandBuffer;
+
+    AudioSystem();
+    ~AudioSystem();
+
+    AudioSystem(const AudioSystem&) = delete;
+    AudioSystem& operator=(const AudioSystem&) = delete;
+
+    ma_engine* m_engine{nullptr};
+    AudioSettings m_settings;
+
+    std::vector<std::shared_ptr<AudioClip>> m_clips;
+    std::unordered_map<std::string, Clip> m_paths;
+
+    std::unique_ptr<VoiceSlot[]> m_voices;
+    unsigned m_voice_count{0};
+    uint64_t m_play_order{0};
+
+    glm::vec3 m_listener{0.f, 0.f, 0.f};
+    glm::vec3 m_listener_dir{0.f, 0.f, -1.f};
+    glm::vec3 m_sent_listener{0.f, 0.f, 0.f};
+    glm::vec3 m_sent_listener_dir{0.f, 0.f, -1.f};
+
+    std::unique_ptr<CommandBuffer> m_commands;
+
+    std::vector<float> m_mix_buffer;
+    double m_mix_pending{0.0};
+
+    VoiceSlot* find(Voice voice) const;
+    VoiceSlot* acquire(int priority);
+    bool steals(const VoiceSlot& slot, const VoiceSlot& victim) const;
+    void release(VoiceSlot& slot);
+
+    bool isAudible(const VoiceSlot& slot) const;
+    void virtualize(VoiceSlot& slot);
+    void devirtualize(VoiceSlot& slot);
+    bool advance(VoiceSlot& slot, float dt);
+
+    void start(VoiceSlot& slot, uint64_t frame);
+    bool pending(const VoiceSlot& slot) const;
+    void retire(VoiceSlot& slot);
+
+    // Hilo de juego
+    uint64_t send(const Command& cmd);
+    void flush();
+    void reclaim();
+
+    // Hilo de audio
+    void drain();
+    void apply(const Command& cmd);
+};
+
+
+#endif // AUDIO_SYSTEM_HPP
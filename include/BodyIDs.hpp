@@ -0,0 +1,48 @@
+#ifndef BODY_IDS_HPP
+#define BODY_IDS_HPP
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Body/BodyManager.h>
+
+#include <GLS/Body.hpp>
+
+/**
+ * BodyID de Jolt de los cuerpos del motor.
+ *
+ * Engine::Body no expone su BodyID, así que el juego lo averigua al crear cada
+ * cuerpo: Track() se llama justo después de CreateBox() o cloneGameObject() y
+ * busca en el PhysicsSystem el cuerpo que aún no estaba apuntado (si aparece
+ * más de uno, el que está en la posición del Body). Sólo se recorre la lista de
+ * cuerpos al crear; Find() es una búsqueda en tabla hash.
+ *
+ * Un cuerpo que no ha pasado por Track() devuelve un BodyID inválido.
+ */
+class BodyIDs
+{
+    public:
+    static BodyIDs& Get();
+
+    JPH::BodyID Track(const std::shared_ptr<Engine::Body>& body);
+    JPH::BodyID Find(const std::shared_ptr<Engine::Body>& body) const;
+
+    private:
+    BodyIDs() = default;
+
+    BodyIDs(const BodyIDs&) = delete;
+    BodyIDs& operator=(const BodyIDs&) = delete;
+
+    static constexpr uint32_t Unknown = ~uint32_t(0);
+
+    std::unordered_map<const Engine::Body*, JPH::BodyID> m_ids;
+    std::vector<uint32_t> m_known;      // Índice del BodyID -> índice y secuencia ya vistos
+    JPH::BodyIDVector m_bodies;
+    std::vector<JPH::BodyID> m_new;
+};
+
+
+#endif // BODY_IDS_HPP
@@ -0,0 +1,129 @@
+#ifndef CHARACTER_CONTROLLER_HPP
+#define CHARACTER_CONTROLLER_HPP
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Physics/Character/CharacterVirtual.h>
+
+#include <GLS/ScriptComponent.hpp>
+#include <GLS/GameObject.hpp>
+#include <GLS/Listener.hpp>
+
+#include "CollisionLayers.hpp"
+#include "Snapshotable.hpp"
+
+
+struct CharacterSettings
+{
+    float half_height = 0.35f;      // Mitad del cilindro de la cápsula
+    float radius = 0.25f;           // half_height + radius = mitad de la altura total
+    float max_slope_angle = 45.f;   // Grados, pendientes mayores se consideran paredes
+    float step_up = 0.3f;           // Altura máxima de escalón que se sube caminando
+    float stick_to_floor = 0.5f;    // Distancia para pegarse al suelo al bajar rampas
+    float move_speed = 4.f;
+    float jump_speed = 6.f;
+    float fixed_step = 1.f / 60.f;  // Paso fijo de simulación del personaje
+    unsigned max_sub_steps = 4;
+    std::string layer = "player";   // Capa en CollisionLayers
+};
+
+/**
+ * Controlador cinemático del jugador basado en JPH::CharacterVirtual.
+ *
+ * Se adjunta como script al GameObject del jugador. El Body del GameObject debe ser
+ * Kinematic: sólo sigue la posición del personaje para que el motor sincronice el
+ * transform y la cámara. Los contactos del jugador se reportan aquí directamente
+ * (sin pasar por el Listener), y el estado de suelo se consulta con getGroundState().
+ * Los solapamientos con sensores se reenvían a Triggers.
+ */
+class CharacterController: public Engine::ScriptComponent, public JPH::CharacterContactListener, public Snapshotable
+{
+    public:
+    using Event = Engine::Listener::Event;
+    using Callback = Engine::Listener::Callback;
+    using StepCallback = std::function<void(float)>;
+
+    CharacterController(const glm::vec3& pos, const CharacterSettings& settings = {});
+    ~CharacterController();
+
+    // Dirección de movimiento en espacio mundo (se ignora la componente Y)
+    void setMoveDirection(const glm::vec3& dir) noexcept;
+
+    // Solicita un salto, se consume en el siguiente paso si el personaje está apoyado
+    void jump() noexcept;
+
+    // Se llama al inicio de cada paso fijo, antes de mover al personaje (entrada, IA...)
+    void setOnStep(StepCallback callback) noexcept;
+
+    void setPosition(const glm::vec3& pos);
+    void setLinearVelocity(const glm::vec3& velocity);
+    glm::vec3 getPosition() const;
+    glm::vec3 getLinearVelocity() const;
+
+    // Consultas de suelo
+    JPH::CharacterBase::EGroundState getGroundState() const;
+    bool isGrounded() const;
+    bool isOnSteepGround() const;
+    bool isSlopeTooSteep(const glm::vec3& normal) const;
+    glm::vec3 getGroundNormal() const;
+    glm::vec3 getGroundVelocity() const;
+    JPH::BodyID getGroundBodyID() const;
+
+    // Callbacks de contacto entre el personaje y un cuerpo
+    void Add(Event event, JPH::BodyID id, Callback callback);
+    void Add(Event event, const std::shared_ptr<Engine::GameObject>& object, Callback callback);
+
+    JPH::CharacterVirtual& getCharacter() { return *m_character; }
+
+    void SaveState(JPH::StateRecorder& stream) const override;
+    void RestoreState(JPH::StateRecorder& stream) override;
+
+    protected:
+    void OnPhysicsUpdate(float dt) override;
+
+    void OnContactAdded(
+        const JPH::CharacterVirtual *inCharacter,
+        const JPH::BodyID &inBodyID2,
+        const JPH::SubShapeID &inSubShapeID2,
+        JPH::RVec3Arg inContactPosition,
+        JPH::Vec3Arg inContactNormal,
+        JPH::CharacterContactSettings &ioSettings) override;
+
+    void OnContactRemoved(
+        const JPH::CharacterVirtual *inCharacter,
+        const JPH::BodyID &inBodyID2,
+        const JPH::SubShapeID &inSubShapeID2) override;
+
+    private:
+    using Key = uint32_t;
+
+    CharacterSettings m_settings;
+    CollisionLayers::Layer m_layer;
+    JPH::Ref<JPH::CharacterVirtual> m_character;
+    JPH::CharacterVirtual::ExtendedUpdateSettings m_update_settings;
+    JPH::TempAllocatorImpl m_allocator;
+
+    glm::vec3 m_move_dir{0.f, 0.f, 0.f};
+    bool m_jump_requested{false};
+    StepCallback m_on_step;
+    float m_accumulator{0.f};
+
+    std::unordered_map<Key, std::vector<Callback>> m_callbacks_added;
+    std::unordered_map<Key, std::vector<Callback>> m_callbacks_removed;
+
+    // Los callbacks se difieren hasta terminar la actualización del personaje
+    std::vector<Callback> m_pending;
+
+    void step(float dt);
+    void dispatch();
+};
+
+
+#endif // CHARACTER_CONTROLLER_HPP
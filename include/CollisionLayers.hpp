@@ -0,0 +1,180 @@
+#ifndef COLLISION_LAYERS_HPP
+#define COLLISION_LAYERS_HPP
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyFilter.h>
+#include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
+#include <Jolt/Physics/Collision/ObjectLayer.h>
+
+#include <GLS/Body.hpp>
+
+/**
+ * Capas de colisión derivadas de los tags de los obstáculos.
+ *
+ * Cada tag se registra como una capa (máximo MaxLayers) y la matriz de colisión
+ * decide qué pares de capas pueden colisionar. Cada capa es una ObjectLayer de
+ * Jolt y va a uno de los árboles de la broadphase (BroadPhase). Las interfaces
+ * de capas de la clase las instala PhysicsSetup en PhysicsSystem::Init(), así
+ * que la matriz se aplica en la broadphase: un cuerpo activo ni siquiera
+ * recorre un árbol en el que no hay ninguna capa con la que pueda colisionar
+ * (p. ej. plataformas y enemigos contra el árbol Scenery), y los pares de capas
+ * que no colisionan se descartan antes de comparar AABBs.
+ *
+ * Por defecto todas las capas colisionan entre sí y van al árbol Moving. Los
+ * cuerpos sin capa conservan las capas del motor (0 estáticos, 1 el resto) y
+ * colisionan con todo. La capa Parked no colisiona con nada y tiene su propio
+ * árbol: la usa ObjectPool para dejar cuerpos en la broadphase sin que nadie
+ * los recorra.
+ *
+ * El árbol de un tag se fija con SetBroadPhase() antes de crear sus cuerpos; la
+ * matriz se puede cambiar en cualquier momento.
+ */
+class CollisionLayers
+{
+    public:
+    using Layer = uint32_t;
+
+    static constexpr Layer MaxLayers = 32;
+    static constexpr Layer Invalid = ~Layer(0);
+    static constexpr Layer Parked = MaxLayers;
+
+    // Capas de objeto del motor para los cuerpos sin tag; las de los tags van detrás
+    static constexpr JPH::ObjectLayer EngineStatic = 0;
+    static constexpr JPH::ObjectLayer EngineMoving = 1;
+    static constexpr JPH::ObjectLayer FirstTagLayer = 2;
+
+    // Árboles de la broadphase
+    enum class BroadPhase : uint8_t
+    {
+        Static,     // Cuerpos estáticos sin tag
+        Moving,     // Cuerpos sin tag que se mueven y tags por defecto
+        Scenery,    // Tags de escenario que no colisionan entre sí
+        Parked,
+        Count
+    };
+
+    static JPH::ObjectLayer ToObjectLayer(Layer layer)
+    {
+        return layer == Invalid ? EngineMoving : JPH::ObjectLayer(FirstTagLayer + layer);
+    }
+
+    static Layer FromObjectLayer(JPH::ObjectLayer layer)
+    {
+        return layer < FirstTagLayer ? Invalid : Layer(layer - FirstTagLayer);
+    }
+
+    /**
+     * Filtro para consultas (personaje, raycasts...) que respeta la matriz de colisión.
+     */
+    class BodyFilter : public JPH::BodyFilter
+    {
+        public:
+        BodyFilter(const CollisionLayers& layers, Layer layer, JPH::BodyID ignore = JPH::BodyID());
+
+        bool ShouldCollide(const JPH::BodyID& inBodyID) const override;
+        bool ShouldCollideLocked(const JPH::Body& inBody) const override;
+
+        private:
+        const CollisionLayers& m_layers;
+        Layer m_layer;
+        JPH::BodyID m_ignore;
+    };
+
+    static CollisionLayers& Get();
+
+    // Registra un tag como capa (si ya existe devuelve la capa existente)
+    Layer Register(const std::string& tag);
+
+    Layer Find(const std::string& tag) const;
+
+    void SetCollision(const std::string& tag1, const std::string& tag2, bool collide);
+    void SetCollision(Layer layer1, Layer layer2, bool collide);
+
+    bool ShouldCollide(Layer layer1, Layer layer2) const;
+
+    // Árbol de la broadphase de un tag (Moving o Scenery), antes de crear sus cuerpos
+    void SetBroadPhase(const std::string& tag, BroadPhase broadphase);
+
+    // Asigna la capa del tag a un cuerpo (registrándola si hace falta)
+    void Assign(const std::shared_ptr<Engine::Body>& body, const std::string& tag);
+
+    // Asigna una capa ya registrada (Parked incluida); Invalid devuelve el cuerpo a la capa del motor
+    void Assign(const std::shared_ptr<Engine::Body>& body, Layer layer);
+
+    BodyFilter MakeBodyFilter(Layer layer, JPH::BodyID ignore = JPH::BodyID()) const;
+
+    // Filtros de broadphase y de capa de objeto para consultas lanzadas desde una capa
+    JPH::DefaultBroadPhaseLayerFilter MakeBroadPhaseFilter(Layer layer) const;
+    JPH::DefaultObjectLayerFilter MakeObjectLayerFilter(Layer layer) const;
+
+    // Interfaces para PhysicsSystem::Init(), las instala PhysicsSetup
+    const JPH::BroadPhaseLayerInterface& GetBroadPhaseLayerInterface() const { return m_broadphase_layers; }
+    const JPH::ObjectVsBroadPhaseLayerFilter& GetObjectVsBroadPhaseFilter() const { return m_broadphase_filter; }
+    const JPH::ObjectLayerPairFilter& GetObjectLayerPairFilter() const { return m_pair_filter; }
+
+    // true si el PhysicsSystem usa estas capas
+    bool IsInstalled() const;
+
+    private:
+    class BroadPhaseLayers final : public JPH::BroadPhaseLayerInterface
+    {
+        public:
+        explicit BroadPhaseLayers(const CollisionLayers& layers): m_layers(layers) {}
+
+        JPH::uint GetNumBroadPhaseLayers() const override { return JPH::uint(BroadPhase::Count); }
+        JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer inLayer) const override;
+
+        #if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+        const char* GetBroadPhaseLayerName(JPH::BroadPhaseLayer inLayer) const override;
+        #endif
+
+        private:
+        const CollisionLayers& m_layers;
+    };
+
+    class BroadPhaseFilter final : public JPH::ObjectVsBroadPhaseLayerFilter
+    {
+        public:
+        explicit BroadPhaseFilter(const CollisionLayers& layers): m_layers(layers) {}
+
+        bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const override;
+
+        private:
+        const CollisionLayers& m_layers;
+    };
+
+    class PairFilter final : public JPH::ObjectLayerPairFilter
+    {
+        public:
+        explicit PairFilter(const CollisionLayers& layers): m_layers(layers) {}
+
+        bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::ObjectLayer inLayer2) const override;
+
+        private:
+        const CollisionLayers& m_layers;
+    };
+
+    CollisionLayers();
+
+    CollisionLayers(const CollisionLayers&) = delete;
+    CollisionLayers& operator=(const CollisionLayers&) = delete;
+
+    std::unordered_map<std::string, Layer> m_tags;
+    std::array<uint32_t, MaxLayers> m_matrix;
+    std::array<BroadPhase, MaxLayers> m_broadphase;
+    uint32_t m_scenery{0};      // Capas en el árbol Scenery
+    Layer m_count{0};
+    bool m_warned{false};
+
+    BroadPhaseLayers m_broadphase_layers;
+    BroadPhaseFilter m_broadphase_filter;
+    PairFilter m_pair_filter;
+};
+
+
+#endif // COLLISION_LAYERS_HPP
@@ -0,0 +1,64 @@
+#ifndef COMMAND_QUEUE_HPP
+#define COMMAND_QUEUE_HPP
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Cola lock-free de un productor y un consumidor con capacidad fija.
+ *
+ * El productor escribe con push() y hace visible el lote entero con publish(),
+ * así el consumidor nunca ve medio frame de comandos. Ninguno de los dos lados
+ * bloquea: si la cola está llena push() devuelve false.
+ *
+ * Los contadores son monótonos, written() y consumed() sirven para saber si un
+ * comando concreto ya se ha aplicado.
+ */
+template<typename T, size_t Capacity>
+class CommandQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "La capacidad debe ser potencia de dos");
+
+    public:
+    // Productor
+    bool push(const T& item)
+    {
+        if(m_write - m_head.load(std::memory_order_acquire) == Capacity)
+            return false;
+
+        m_items[m_write & (Capacity - 1)] = item;
+        m_write++;
+        return true;
+    }
+
+    void publish() { m_tail.store(m_write, std::memory_order_release); }
+
+    uint64_t written() const { return m_write; }
+
+    // Consumidor
+    template<typename F>
+    size_t drain(F&& apply)
+    {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        uint64_t tail = m_tail.load(std::memory_order_acquire);
+
+        for(uint64_t i = head; i != tail; i++)
+            apply(m_items[i & (Capacity - 1)]);
+
+        m_head.store(tail, std::memory_order_release);
+        return size_t(tail - head);
+    }
+
+    uint64_t consumed() const { return m_head.load(std::memory_order_acquire); }
+
+    private:
+    std::array<T, Capacity> m_items{};
+
+    alignas(64) std::atomic<uint64_t> m_head{0};
+    alignas(64) std::atomic<uint64_t> m_tail{0};
+    alignas(64) uint64_t m_write{0};
+};
+
+
+#endif // COMMAND_QUEUE_HPP
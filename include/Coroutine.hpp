@@ -0,0 +1,269 @@
+#ifndef COROUTINE_HPP
+#define COROUTINE_HPP
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Collision/ContactListener.h>
+
+#include <GLS/Body.hpp>
+#include <GLS/ScriptComponent.hpp>
+
+#include "BodyIDs.hpp"
+#include "Snapshotable.hpp"
+#include "Streamable.hpp"
+
+
+/**
+ * Espera pendiente de una corrutina. Los awaitables heredan de aquí y viven en
+ * el frame de la corrutina mientras está suspendida.
+ */
+struct CoroutineWait
+{
+    std::coroutine_handle<> handle;
+    uint64_t tick = 0;              // Tick de la rueda en el que despertar
+    JPH::BodyID body;               // Cuerpo esperado en wait_for_contact
+    bool timer = false;
+
+    virtual ~CoroutineWait() = default;
+
+    // Segundos que faltan al despertar; > 0 vuelve a la rueda sin reanudar
+    virtual float remaining() const { return 0.f; }
+};
+
+/**
+ * Planificador de corrutinas de scripts.
+ *
+ * Las esperas por tiempo van a una rueda de temporizadores de WheelSize huecos
+ * de TickLength segundos: avanzar sólo mira el hueco del tick actual. Las
+ * esperas por contacto se guardan por BodyID y se despiertan cuando llega un
+ * contacto de ese cuerpo (desde el ContactListener del sistema, en cualquier
+ * hilo, o desde el CharacterController). Nada suspendido se consulta por frame.
+ *
+ * El reloj lo avanza CoroutineClock con el dt de la física, así que se para en
+ * pausa igual que la simulación.
+ */
+class CoroutineScheduler : public JPH::ContactListener
+{
+    public:
+    static constexpr float TickLength = 1.f / 60.f;
+    static constexpr size_t WheelSize = 256;
+
+    static CoroutineScheduler& Get();
+
+    // Se coloca delante del ContactListener actual del PhysicsSystem
+    void attachContacts();
+
+    void advance(float dt);
+    float now() const { return float(m_tick) * TickLength; }
+
+    void sleep(CoroutineWait& wait, float seconds);
+    void waitContact(CoroutineWait& wait);
+    void cancel(CoroutineWait& wait);
+
+    // Seguro desde cualquier hilo, se despacha en el siguiente advance()
+    void notifyContact(JPH::BodyID body);
+
+    size_t getPending() const { return m_pending; }
+
+    JPH::ValidateResult OnContactValidate(
+        const JPH::Body& inBody1,
+        const JPH::Body& inBody2,
+        JPH::RVec3Arg inBaseOffset,
+        const JPH::CollideShapeResult& inCollisionResult) override;
+
+    void OnContactAdded(
+        const JPH::Body& inBody1,
+        const JPH::Body& inBody2,
+        const JPH::ContactManifold& inManifold,
+        JPH::ContactSettings& ioSettings) override;
+
+    void OnContactPersisted(
+        const JPH::Body& inBody1,
+        const JPH::Body& inBody2,
+        const JPH::ContactManifold& inManifold,
+        JPH::ContactSettings& ioSettings) override;
+
+    void OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) override;
+
+    private:
+    CoroutineScheduler() = default;
+
+    CoroutineScheduler(const CoroutineScheduler&) = delete;
+    CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+
+    JPH::ContactListener* m_next{nullptr};
+    bool m_attached{false};
+
+    std::array<std::vector<CoroutineWait*>, WheelSize> m_wheel;
+    uint64_t m_tick{0};
+    float m_accumulator{0.f};
+    size_t m_pending{0};
+
+    std::unordered_map<uint32_t, std::vector<CoroutineWait*>> m_contact_waits;
+
+    // Los contactos llegan desde los hilos de Jolt; sólo se guardan si alguien espera
+    std::atomic<size_t> m_contact_waiters{0};
+    std::mutex m_contacts_mutex;
+    std::vector<uint32_t> m_contacts;
+
+    // Esperas cumplidas pendientes de reanudar (cancel() también las quita de aquí)
+    std::vector<CoroutineWait*> m_ready;
+
+    void schedule(CoroutineWait& wait, float seconds);
+    void fireTimers();
+    void fireContacts();
+    void resumeReady();
+};
+
+/**
+ * Corrutina de un script. Empieza suspendida (start() la arranca) y el frame se
+ * destruye con el objeto, cancelando la espera que tuviera pendiente.
+ */
+class Behaviour
+{
+    public:
+    struct promise_type
+    {
+        CoroutineWait* waiting = nullptr;
+
+        Behaviour get_return_object() { return Behaviour(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception();
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Behaviour() = default;
+    explicit Behaviour(Handle handle) : m_handle(handle) {}
+    ~Behaviour() { reset(); }
+
+    Behaviour(Behaviour&& other) noexcept : m_handle(other.m_handle) { other.m_handle = {}; }
+    Behaviour& operator=(Behaviour&& other) noexcept;
+
+    Behaviour(const Behaviour&) = delete;
+    Behaviour& operator=(const Behaviour&) = delete;
+
+    void start();
+    void reset();
+
+    bool valid() const { return bool(m_handle); }
+    bool done() const { return !m_handle || m_handle.done(); }
+
+    private:
+    Handle m_handle;
+};
+
+// Base de los awaitables: guarda la espera en la promesa para poder cancelarla
+struct CoroutineAwaiter : CoroutineWait
+{
+    void await_resume()
+    {
+        if(handle)
+            Behaviour::Handle::from_address(handle.address()).promise().waiting = nullptr;
+    }
+
+    protected:
+    void bind(Behaviour::Handle handle)
+    {
+        this->handle = handle;
+        handle.promise().waiting = this;
+    }
+};
+
+struct wait_seconds : CoroutineAwaiter
+{
+    float seconds;
+
+    explicit wait_seconds(float seconds) : seconds(seconds) {}
+
+    bool await_ready() const { return seconds <= 0.f; }
+    void await_suspend(Behaviour::Handle handle);
+};
+
+enum class Axis { X, Y, Z };
+
+/**
+ * Espera a que la coordenada axis del cuerpo llegue a target desde el lado en el
+ * que está ahora. No se consulta cada tick: se estima la llegada con la velocidad
+ * actual y sólo se comprueba al vencer esa estimación. Si el cuerpo está parado
+ * o se aleja se vuelve a mirar cada MaxRecheck segundos.
+ */
+struct wait_until_position : CoroutineAwaiter
+{
+    static constexpr float MaxRecheck = 0.25f;
+    static constexpr float Epsilon = 1e-3f;
+
+    std::shared_ptr<Engine::Body> target_body;
+    Axis axis;
+    float target;
+    float side = 0.f;
+
+    wait_until_position(std::shared_ptr<Engine::Body> body, Axis axis, float target)
+        : target_body(std::move(body)), axis(axis), target(target) {}
+
+    bool await_ready();
+    void await_suspend(Behaviour::Handle handle);
+    float remaining() const override;
+};
+
+// Espera al siguiente contacto (añadido) en el que participe el cuerpo
+struct wait_for_contact : CoroutineAwaiter
+{
+    explicit wait_for_contact(const std::shared_ptr<Engine::Body>& target)
+    {
+        body = target ? BodyIDs::Get().Find(target) : JPH::BodyID();
+    }
+
+    bool await_ready() const { return body.IsInvalid(); }
+    void await_suspend(Behaviour::Handle handle);
+};
+
+/**
+ * Script cuyo comportamiento es una corrutina: run() se arranca en cuanto el
+ * script tiene cuerpo y después sólo se ejecuta cuando una espera se cumple.
+ * Al descargarse con su chunk la corrutina se destruye y vuelve a empezar al
+ * cargarse de nuevo. No se serializa en un SceneSnapshot: al restaurarlo vuelve
+ * a empezar desde la posición restaurada del cuerpo.
+ */
+class CoroutineScript : public Engine::ScriptComponent, public Streamable, public Snapshotable
+{
+    public:
+    void OnStreamIn() override;
+    void OnStreamOut() override;
+
+    void SaveState(JPH::StateRecorder&) const override {}
+    void RestoreState(JPH::StateRecorder& stream) override;
+
+    protected:
+    virtual Behaviour run() = 0;
+
+    void OnStart() override;
+    void OnPhysicsUpdate(float dt) override;
+
+    private:
+    Behaviour m_behaviour;
+    bool m_started{false};
+    bool m_streamed_out{false};
+
+    void begin();
+};
+
+// Avanza el CoroutineScheduler con el paso de la física, uno por juego
+class CoroutineClock : public Engine::ScriptComponent
+{
+    protected:
+    void OnPhysicsUpdate(float dt) override;
+};
+
+
+#endif // COROUTINE_HPP
@@ -0,0 +1,50 @@
+#ifndef FRAME_PACER_HPP
+#define FRAME_PACER_HPP
+#include <functional>
+
+
+struct FramePacerSettings
+{
+    float max_fps = 30.f;       // Tope mientras hay actividad en los menús (0 = sin tope)
+    float idle_fps = 10.f;      // Frames por segundo sin input (0 = sin reposo)
+    float active_time = 0.5f;   // Segundos a max_fps tras cada evento (hover, transiciones...)
+};
+
+/**
+ * Ritmo de frames en pausa.
+ *
+ * El bucle del renderer no se detiene en pausa: sin esto sigue dibujando la
+ * escena y los menús tan rápido como puede. idle() se llama una vez por frame
+ * mientras el juego está pausado y duerme el hilo principal dentro de GLFW hasta
+ * que llega un evento de entrada o vence el intervalo de reposo. Tras un evento
+ * se renderiza a max_fps durante active_time para que las transiciones de la UI
+ * terminen con fluidez, y después se vuelve a idle_fps. Un cambio en lo que se
+ * ve (setRedrawCheck, p. ej. UILayer::consumeChanges()) cuenta como un evento.
+ */
+class FramePacer
+{
+    public:
+    using RedrawCheck = std::function<bool()>;
+
+    explicit FramePacer(const FramePacerSettings& settings = {});
+
+    void idle();
+
+    // Se consulta al principio de cada idle(); true = hay algo nuevo que dibujar
+    void setRedrawCheck(RedrawCheck check);
+
+    // Al salir de la pausa, para que el primer frame no herede el tiempo dormido
+    void reset();
+
+    const FramePacerSettings& getSettings() const { return m_settings; }
+
+    private:
+    FramePacerSettings m_settings;
+    RedrawCheck m_redraw;
+
+    double m_last_frame{0.0};
+    double m_last_event{0.0};
+};
+
+
+#endif // FRAME_PACER_HPP
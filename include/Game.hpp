@@ -7,10 +7,21 @@
 #include <GLS/GameObject.hpp>
 #include <GLS/Listener.hpp>
 #include <GLS/UIManager.hpp>
-#include <GLS/AudioPlayer.hpp>
+
+#include "AudioSystem.hpp"
+#include "SceneSnapshot.hpp"
 
 
 class inputManager;
+class CharacterController;
+class PhysicsMonitor;
+class LatencyMonitor;
+class UIDataModel;
+class UILayer;
+class LevelStreamer;
+class ProjectileSystem;
+struct ProjectileHit;
+template<typename T> class UIValue;
 
 class Game
 {
@@ -30,21 +41,47 @@ public:
     // Función para hacer shutdown explícito de la UI (llamar antes de destruir Game)
     void shutdownUI() noexcept;
 
+    // Estadísticas por paso de la física, report_interval en segundos (0 = sin log)
+    void enablePhysicsStats(float report_interval = 0.f);
+
+    // Latencia de entrada a pantalla, por consola cada report_interval y en el HUD
+    void enableLatencyStats(float report_interval = 0.f);
+
 private:
     std::shared_ptr<Engine::Window> m_window;
     std::shared_ptr<Engine::Scene> m_scene;
     std::shared_ptr<Engine::Renderer> m_renderer;
     std::shared_ptr<inputManager> m_input;
     std::shared_ptr<Engine::GameObject> m_user;
+    std::shared_ptr<CharacterController> m_character;
+    std::shared_ptr<PhysicsMonitor> m_physics_monitor;
+    std::shared_ptr<LatencyMonitor> m_latency_monitor;
     std::shared_ptr<Engine::CameraComponent> m_camera;
-    std::shared_ptr<Engine::AudioPlayer> m_audio_player;
+    AudioSystem::Clip m_music_clip{AudioSystem::InvalidClip};
+    AudioSystem::Voice m_music;
+    // Declarado antes que m_ui_manager: el contexto se destruye primero
+    std::unique_ptr<UIDataModel> m_hud;
+    UIValue<int>* m_lives{nullptr};
+    UIValue<std::string>* m_latency_text{nullptr};
     std::shared_ptr<UIManager> m_ui_manager;
+    std::unique_ptr<UILayer> m_ui_layer;
+
+    std::shared_ptr<LevelStreamer> m_streamer;
+    glm::vec3 m_spawn{-2.f, 0.f, 0.f};
+
+    // Estado del nivel recién cargado (restart) y del último checkpoint (respawn)
+    SceneSnapshot m_level_start;
+    SceneSnapshot m_checkpoint;
+
+    static constexpr float BulletSpeed = 40.f;
+    static constexpr size_t VisibleBullets = 64;
+    std::shared_ptr<ProjectileSystem> m_projectiles;
 
-    Engine:: Listener::Callback ground_collition;
     Engine:: Listener::Callback enemy_collition;
     Engine:: Listener::Callback parachute_collision_on;
     Engine:: Listener::Callback parachute_collision_off;
     Engine:: Listener::Callback goal_collition;
+    Engine:: Listener::Callback checkpoint_reached;
 
     bool parachute_collisioning;
 
@@ -52,10 +89,15 @@ private:
 
     
     void restart();
+    void respawn();
+    void resetPlayer();
+    void fire();
+    void bulletHit(const ProjectileHit& hit);
 
     void handleGameOver() noexcept;
 
     void initScene();
+    void initLayers();
     void initSkyBox();
     void initUser();
     void initInput();
@@ -64,6 +106,8 @@ private:
     void initCollitions();
     void initUI();
     void initAudio();
+    void playMusic();
+    void setLives(int lives);
 };
 
 
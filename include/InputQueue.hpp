@@ -0,0 +1,94 @@
+#ifndef INPUT_QUEUE_HPP
+#define INPUT_QUEUE_HPP
+#include <cstddef>
+#include <deque>
+
+struct GLFWwindow;
+
+
+struct InputEvent
+{
+    enum class Type { Key, MouseButton };
+
+    Type type;
+    int code;       // GLFW_KEY_* o GLFW_MOUSE_BUTTON_*
+    int action;     // GLFW_PRESS, GLFW_RELEASE o GLFW_REPEAT
+    int mods;
+    double time;    // glfwGetTime() en el momento del callback
+};
+
+/**
+ * Cola de eventos de entrada con marca de tiempo.
+ *
+ * Engine::Input sólo guarda el estado actual de teclas y ratón, así que una
+ * pulsación que empieza y acaba dentro del mismo frame se pierde. Esta cola se
+ * engancha a los callbacks de GLFW (encadenando los que ya hubiera, los del
+ * motor y los de RmlUi siguen funcionando) y guarda cada evento con su tiempo.
+ * La simulación la consume por pasos fijos con consume(hasta).
+ *
+ * El ratón no se encola: los desplazamientos se acumulan y takeMouseDelta()
+ * devuelve todo el movimiento desde la última lectura, justo antes de usarlo.
+ */
+class InputQueue
+{
+    public:
+    static constexpr size_t MaxEvents = 256;   // Si nadie consume se descartan los más antiguos
+
+    static InputQueue& Get();
+
+    // Instala los callbacks en la ventana, después de que el motor y la UI pongan los suyos
+    void attach(GLFWwindow* window);
+
+    // Entrega en orden los eventos con time <= until y los quita de la cola
+    template<typename F>
+    size_t consume(double until, F&& handler)
+    {
+        size_t count = 0;
+        while(!m_events.empty() && m_events.front().time <= until)
+        {
+            handler(m_events.front());
+            m_events.pop_front();
+            ++count;
+        }
+        return count;
+    }
+
+    // Movimiento del ratón acumulado desde la última llamada
+    void takeMouseDelta(double& dx, double& dy);
+
+    // Descarta eventos y movimiento pendientes (pausa, menús)
+    void clear();
+
+    size_t size() const { return m_events.size(); }
+
+    private:
+    InputQueue() = default;
+
+    InputQueue(const InputQueue&) = delete;
+    InputQueue& operator=(const InputQueue&) = delete;
+
+    using KeyCallback = void(*)(GLFWwindow*, int, int, int, int);
+    using MouseButtonCallback = void(*)(GLFWwindow*, int, int, int);
+    using CursorPosCallback = void(*)(GLFWwindow*, double, double);
+
+    std::deque<InputEvent> m_events;
+
+    KeyCallback m_next_key{nullptr};
+    MouseButtonCallback m_next_mouse_button{nullptr};
+    CursorPosCallback m_next_cursor{nullptr};
+
+    bool m_has_cursor{false};
+    double m_cursor_x{0.0};
+    double m_cursor_y{0.0};
+    double m_mouse_dx{0.0};
+    double m_mouse_dy{0.0};
+
+    void push(const InputEvent& event);
+
+    static void onKey(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void onMouseButton(GLFWwindow* window, int button, int action, int mods);
+    static void onCursorPos(GLFWwindow* window, double x, double y);
+};
+
+
+#endif // INPUT_QUEUE_HPP
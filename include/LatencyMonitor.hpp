@@ -0,0 +1,92 @@
+#ifndef LATENCY_MONITOR_HPP
+#define LATENCY_MONITOR_HPP
+#include <deque>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <GLS/ScriptComponent.hpp>
+
+#include "UIDataModel.hpp"
+
+
+// Milisegundos desde que llega el evento hasta cada etapa del frame que lo muestra.
+// swap y gpu son cotas superiores: se miden uno o más frames después.
+struct LatencyStats
+{
+    float simulation = 0.f;     // Consumido por un paso fijo
+    float submit = 0.f;         // Frame enviado a dibujar
+    float swap = 0.f;           // Como mucho: swap_buffers ya había vuelto en el OnUpdate siguiente
+    float gpu = 0.f;            // Como mucho: la fence se vio completada al consultarla
+};
+
+/**
+ * Latencia de entrada a pantalla.
+ *
+ * Cada pulsación consumida por la simulación se marca con consumed(). El motor
+ * actualiza los scripts después del paso físico y justo antes de dibujar, así
+ * que OnUpdate marca el envío del frame. El swap no se ve desde los scripts: se
+ * marca en el OnUpdate siguiente, así que incluye la simulación y la espera del
+ * frame siguiente (cota superior). Ahí mismo se inserta la fence GL, un frame
+ * tarde, y se consulta sin bloquear en los frames siguientes, así que gpu
+ * también es una cota superior.
+ *
+ * Se guardan las últimas muestras y se informa de p50/p95/p99 por consola y,
+ * si se da un valor enlazado, en el overlay de la UI.
+ */
+class LatencyMonitor : public Engine::ScriptComponent
+{
+    public:
+    static constexpr size_t MaxSamples = 256;
+
+    explicit LatencyMonitor(float report_interval = 0.f, UIValue<std::string>* overlay = nullptr);
+    ~LatencyMonitor();
+
+    void setOverlay(UIValue<std::string>* overlay) { m_overlay = overlay; }
+
+    // input_time: glfwGetTime() del evento; se llama desde el paso fijo que lo consume
+    void consumed(double input_time);
+
+    // Percentil (0-100) de cada etapa sobre las últimas muestras completas
+    LatencyStats getPercentile(float percentile) const;
+    size_t getSampleCount() const { return m_samples.size(); }
+
+    void print(std::ostream& out) const;
+
+    protected:
+    void OnUpdate(const GLfloat& dt) override;
+
+    private:
+    struct Pending
+    {
+        double input = 0.0;
+        double consumed = 0.0;
+        double submitted = 0.0;
+        double swapped = 0.0;
+    };
+
+    // Frame ya presentado cuya GPU aún no ha terminado
+    struct Frame
+    {
+        GLsync fence = nullptr;
+        std::vector<Pending> pending;
+    };
+
+    float m_report_interval;
+    float m_report_timer{0.f};
+    UIValue<std::string>* m_overlay;
+
+    std::vector<Pending> m_consumed;    // Esperando al envío del frame
+    std::vector<Pending> m_submitted;   // Esperando al swap
+    std::deque<Frame> m_frames;         // Esperando a la GPU
+
+    std::deque<LatencyStats> m_samples;
+
+    void poll(double now);
+    void report();
+};
+
+
+#endif // LATENCY_MONITOR_HPP
@@ -9,7 +9,10 @@
 #include <GLS/Scene.hpp>
 
 #include "Obstacle.hpp"
+#include "Prefab.hpp"
+#include "LevelFormat.hpp"
 
+class LevelFile;
 
 struct ObstacleInit
 {
@@ -19,6 +22,15 @@ struct ObstacleInit
     ObstacleSettings settings;
 };
 
+// Lo que un nivel en fichero no puede guardar: punteros y funciones del juego
+struct LevelBindings
+{
+    unsigned user_index{0};
+    std::shared_ptr<CharacterController> character;
+    std::unordered_map<std::string, Engine::Listener::Callback> callbacks;   // on_start / on_end
+    std::unordered_map<std::string, ScriptSpec> scripts;                     // script @nombre
+};
+
 class Level
 {
     private:
@@ -33,6 +45,22 @@ class Level
         ~Level();
 
         void init(const init_list& list);
+
+        // Crea los obstáculos de un nivel binario; false si algún registro no es válido
+        bool load(const LevelFile& file, const LevelBindings& bindings);
+
+        // Prefabs del fichero (uno por registro, en el mismo orden) registrados en PrefabLibrary
+        static bool resolve(const LevelFile& file, const LevelBindings& bindings, std::vector<std::shared_ptr<const Prefab>>& prefabs);
+
+        // Overrides de una colocación que los tiene
+        static bool resolveOverrides(const LevelFile& file, const LevelFormat::Placement& place, PrefabOverrides& overrides);
+
+        std::shared_ptr<Obstacle> instantiate(const Prefab& prefab, const glm::vec3& pos, const PrefabOverrides* overrides = nullptr);
+
+        // Los obstáculos con el mismo tag clonan el modelo y el cuerpo del primero
+        std::shared_ptr<Obstacle> spawn(const std::string& filename, const std::string& tag, const glm::vec3& pos, const ObstacleSettings& settings);
+
+        const std::vector<std::shared_ptr<Obstacle>>& getObstacles() const;
 };
 
 
@@ -0,0 +1,101 @@
+#ifndef LEVEL_COMPILER_HPP
+#define LEVEL_COMPILER_HPP
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "LevelFormat.hpp"
+
+
+/**
+ * Convierte un nivel en texto a LevelFormat.
+ *
+ * Formato fuente, una orden por línea (# comenta hasta el final):
+ *
+ *   use ../prefabs/common.txt              # prefabs compartidos (ruta relativa a este fichero)
+ *
+ *   prefab plataforma3 : plataforma        # hereda de un prefab anterior
+ *       model ground/base.fbx              # sin model (o model -) = sin modelo
+ *       tag plataforma                     # capa de colisión por defecto
+ *       box 1 0.25 1                       # box_shape (sin caja = sin cuerpo)
+ *       body kinematic                     # static | dynamic | kinematic
+ *       rel_pos 0 -0.25 0                  # también rel_scale, rel_axis, rel_angle
+ *       scale 1 1 1                        # también axis, angle
+ *       layer plataforma
+ *       sensor
+ *       character                          # contactos vía CharacterController
+ *       on_start enemy                     # callbacks por nombre (los aporta el juego)
+ *       on_end enemy_off
+ *       script PlataformaMovil min=-3 max=3 vertical=false
+ *       script @parachute                  # script que construye el juego
+ *   end
+ *
+ *   place plataforma3 -3 3 34                      # prefab, x y z
+ *   place plataforma3 3 3 38 max=6 scale=2,1,2     # con modificaciones de esta instancia
+ *
+ * Las modificaciones de una colocación son scale=x,y,z, axis=x,y,z, angle=g y
+ * cualquier parámetro del script del prefab. Los nombres de scripts y
+ * parámetros se comprueban al cargar, contra el ScriptRegistry, así que el
+ * compilador no depende del juego.
+ */
+class LevelCompiler
+{
+    public:
+    bool compile(const std::filesystem::path& source, const std::filesystem::path& output);
+
+    // Compila sólo si el binario no existe o es más antiguo que la fuente (o sus use)
+    bool cook(const std::filesystem::path& source, const std::filesystem::path& output);
+
+    size_t getPlacementCount() const { return m_placements.size(); }
+
+    private:
+    struct ParamDef
+    {
+        std::string name;
+        LevelFormat::Param value;
+    };
+
+    struct PrefabDef
+    {
+        std::string name;
+        std::string model;
+        std::string tag;
+        LevelFormat::Settings record;
+        std::string layer;
+        std::string on_start;
+        std::string on_end;
+        std::string script;
+        std::vector<ParamDef> params;
+    };
+
+    struct OverrideDef
+    {
+        LevelFormat::Override record;
+        std::vector<ParamDef> params;
+    };
+
+    struct PlacementDef
+    {
+        uint32_t prefab;
+        uint32_t override;
+        float pos[3];
+    };
+
+    std::vector<PrefabDef> m_prefabs;
+    std::unordered_map<std::string, uint32_t> m_prefab_names;
+    std::vector<OverrideDef> m_overrides;
+    std::vector<PlacementDef> m_placements;
+    std::vector<std::filesystem::path> m_sources;   // Para cook() y para no incluir dos veces
+
+    std::string m_chars;
+    std::unordered_map<std::string, LevelFormat::String> m_strings;
+
+    void clear();
+    bool parse(const std::filesystem::path& source);
+    bool write(const std::filesystem::path& output);
+    LevelFormat::String intern(const std::string& value);
+};
+
+
+#endif // LEVEL_COMPILER_HPP
@@ -0,0 +1,58 @@
+#ifndef LEVEL_FILE_HPP
+#define LEVEL_FILE_HPP
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "LevelFormat.hpp"
+
+
+/**
+ * Nivel binario mapeado en memoria (sólo lectura).
+ *
+ * open() valida cabecera, versión y que todas las secciones caen dentro del
+ * fichero; después los registros se leen directamente del mapeo. Las páginas
+ * las trae el sistema bajo demanda y se comparten con la caché de ficheros.
+ */
+class LevelFile
+{
+    public:
+    LevelFile() = default;
+    ~LevelFile();
+
+    LevelFile(const LevelFile&) = delete;
+    LevelFile& operator=(const LevelFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    std::span<const LevelFormat::Param> params() const { return section<LevelFormat::Param>(LevelFormat::Section::Params); }
+    std::span<const LevelFormat::Script> scripts() const { return section<LevelFormat::Script>(LevelFormat::Section::Scripts); }
+    std::span<const LevelFormat::Prefab> prefabs() const { return section<LevelFormat::Prefab>(LevelFormat::Section::Prefabs); }
+    std::span<const LevelFormat::Override> overrides() const { return section<LevelFormat::Override>(LevelFormat::Section::Overrides); }
+    std::span<const LevelFormat::Placement> placements() const { return section<LevelFormat::Placement>(LevelFormat::Section::Placements); }
+
+    // Vacío si la referencia se sale de la sección de strings
+    std::string_view str(const LevelFormat::String& ref) const;
+
+    private:
+    const unsigned char* m_data{nullptr};
+    size_t m_size{0};
+
+    const LevelFormat::Header& header() const { return *reinterpret_cast<const LevelFormat::Header*>(m_data); }
+
+    template<typename T>
+    std::span<const T> section(LevelFormat::Section id) const
+    {
+        if(!m_data)
+            return {};
+
+        const auto& ref = header().sections[size_t(id)];
+        return {reinterpret_cast<const T*>(m_data + ref.offset), ref.count};
+    }
+};
+
+
+#endif // LEVEL_FILE_HPP
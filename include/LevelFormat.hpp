@@ -0,0 +1,139 @@
+#ifndef LEVEL_FORMAT_HPP
+#define LEVEL_FORMAT_HPP
+#include <cstdint>
+#include <type_traits>
+
+
+/**
+ * Formato binario de nivel (.lvl).
+ *
+ * Cabecera fija seguida de secciones de registros de tamaño fijo, alineados a
+ * 4 bytes, que se leen en el sitio desde el fichero mapeado en memoria: no hay
+ * parseo ni reservas por registro. Los strings son (offset, length) dentro de la
+ * sección Chars y están deduplicados por el compilador, así que dos registros
+ * con el mismo tag comparten offset.
+ *
+ * Cada prefab (modelo, tag y ajustes) se guarda una vez y las colocaciones sólo
+ * llevan su índice, su posición y, si la tienen, una modificación dispersa
+ * (Override), de modo que el coste de carga que no es del motor es proporcional
+ * al número de prefabs distintos, no al de obstáculos.
+ *
+ * Cualquier cambio en estos structs sube Version.
+ */
+namespace LevelFormat
+{
+    constexpr char Magic[4] = {'G', 'L', 'V', 'L'};
+    constexpr uint32_t Version = 2;
+    constexpr uint32_t NoIndex = UINT32_MAX;
+
+    enum class Section : uint32_t { Chars, Params, Scripts, Prefabs, Overrides, Placements, Count };
+    constexpr uint32_t SectionCount = uint32_t(Section::Count);
+
+    enum class BodyType : uint8_t { Static, Dynamic, Kinematic };
+    enum class ParamType : uint8_t { Float, Int, Bool };
+
+    struct String
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct SectionRef
+    {
+        uint32_t offset;        // Desde el principio del fichero
+        uint32_t count;         // Registros (bytes en Chars)
+    };
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t size;          // Tamaño total del fichero
+        uint32_t reserved;
+        SectionRef sections[SectionCount];
+    };
+
+    // Parámetro tipado de un script, se valida contra sus Fields al cargar
+    struct Param
+    {
+        String name;
+        uint8_t type;
+        uint8_t pad[3];
+        union
+        {
+            float f;
+            int32_t i;
+        };
+    };
+
+    // Script por nombre con sus parámetros, o "@nombre" para uno que aporta el juego
+    struct Script
+    {
+        String name;
+        uint32_t first_param;
+        uint32_t param_count;
+    };
+
+    struct Settings
+    {
+        float box_shape[3];
+        float rel_pos[3];
+        float rel_scale[3];
+        float rel_axis[3];
+        float rel_angle;
+        float scale[3];
+        float axis[3];
+        float angle;
+        String layer;
+        String on_start;        // Nombres de callbacks que aporta el juego
+        String on_end;
+        uint32_t script;        // Índice en Scripts o NoIndex
+        uint8_t body_type;
+        uint8_t sensor;
+        uint8_t character;      // Contactos registrados en el CharacterController
+        uint8_t pad;
+    };
+
+    struct Prefab
+    {
+        String name;
+        String model;
+        String tag;
+        Settings settings;
+    };
+
+    enum OverrideField : uint32_t
+    {
+        OverrideScale = 1 << 0,
+        OverrideRotation = 1 << 1,  // axis + angle
+        OverrideParams = 1 << 2,    // Se aplican sobre los parámetros del script del prefab
+    };
+
+    struct Override
+    {
+        uint32_t fields;
+        float scale[3];
+        float axis[3];
+        float angle;
+        uint32_t first_param;
+        uint32_t param_count;
+    };
+
+    struct Placement
+    {
+        uint32_t prefab;
+        uint32_t override;      // Índice en Overrides o NoIndex
+        float pos[3];
+    };
+
+    static_assert(std::is_trivially_copyable<Header>::value && sizeof(Header) == 16 + 8 * SectionCount);
+    static_assert(sizeof(Param) == 16);
+    static_assert(sizeof(Script) == 16);
+    static_assert(sizeof(Settings) == 112);
+    static_assert(sizeof(Prefab) == 136);
+    static_assert(sizeof(Override) == 40);
+    static_assert(sizeof(Placement) == 20);
+}
+
+
+#endif // LEVEL_FORMAT_HPP
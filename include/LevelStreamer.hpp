@@ -0,0 +1,151 @@
+#ifndef LEVEL_STREAMER_HPP
+#define LEVEL_STREAMER_HPP
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <GLS/Scene.hpp>
+#include <GLS/ScriptComponent.hpp>
+
+#include "Level.hpp"
+#include "LevelFile.hpp"
+#include "ObjectPool.hpp"
+#include "Snapshotable.hpp"
+
+
+struct StreamingSettings
+{
+    float chunk_size = 32.f;            // Lado de un chunk en XZ
+    float load_radius = 64.f;           // Se cargan los chunks a esta distancia del jugador
+    float unload_radius = 96.f;         // y se descargan más allá de esta (histéresis)
+    unsigned spawns_per_frame = 16;     // Obstáculos nuevos (modelo + cuerpo) por frame, en el hilo de juego
+};
+
+/**
+ * Carga por chunks de un nivel binario alrededor del jugador.
+ *
+ * Al abrir el nivel las colocaciones se reparten en una rejilla XZ de
+ * chunk_size; el fichero sigue mapeado y cada chunk sólo guarda índices. Cuando
+ * el jugador cambia de celda se encolan los chunks dentro de load_radius (el
+ * más cercano primero) y se descargan los que quedan fuera de unload_radius.
+ *
+ * La carga no es asíncrona: modelos, formas y cuerpos se crean en el hilo de
+ * juego (los modelos suben a OpenGL y la escena del motor no admite otro
+ * hilo), sólo se reparten entre frames. Cada update() crea como mucho
+ * spawns_per_frame obstáculos nuevos, ocultos y fuera de la simulación, y el
+ * chunk se activa entero cuando están todos, para no aparecer a medias. Los
+ * que se reutilizan de un pool no cuentan: no crean nada.
+ *
+ * La escena del motor no permite borrar GameObjects, así que cada prefab tiene
+ * un ObjectPool que crece bajo demanda: descargar un chunk devuelve sus objetos
+ * a su pool (ocultos, dormidos y en la capa Parked, así que los contactos y
+ * triggers dejan de llegar) y un chunk que se carga después los reutiliza
+ * (mismo modelo, cuerpo, listeners y script) en sus nuevas posiciones. Las
+ * instancias con escala o parámetros de script propios tienen un pool para esa
+ * colocación. Los objetos y cuerpos creados quedan acotados por lo que cabe en
+ * el radio de carga, no por la longitud del nivel.
+ *
+ * En un SceneSnapshot el streamer guarda qué chunks estaban activos y el estado
+ * de cada uno de sus objetos. Al restaurar descarga los chunks que no estaban,
+ * carga de golpe los que faltan (reutilizando instancias de los pools, sin
+ * assets nuevos) y devuelve a cada colocación su estado; los chunks que se
+ * cargan después de capturar no entran en el snapshot.
+ */
+class LevelStreamer : public Snapshotable
+{
+    public:
+    LevelStreamer(std::shared_ptr<Engine::Scene> scene, const StreamingSettings& settings = {});
+
+    LevelStreamer(const LevelStreamer&) = delete;
+    LevelStreamer& operator=(const LevelStreamer&) = delete;
+
+    bool open(const std::string& path, const LevelBindings& bindings);
+
+    void update(const glm::vec3& player);
+
+    // Carga completa (sin repartir entre frames) alrededor de la posición
+    void warmup(const glm::vec3& player);
+
+    // Descarga todos los chunks; al volver a cargarlos sus objetos empiezan de cero
+    void reset();
+
+    // Oculta el objeto cargado con ese cuerpo hasta que su chunk se vuelva a cargar
+    bool hide(JPH::BodyID body);
+
+    // Chunks activos y estado de sus objetos (un chunk a medio cargar no cuenta)
+    void SaveState(JPH::StateRecorder& stream) const override;
+    void RestoreState(JPH::StateRecorder& stream) override;
+
+    size_t getChunkCount() const { return m_chunks.size(); }
+    size_t getResidentChunks() const { return m_resident.size(); }
+    size_t getActiveObjects() const { return m_active_objects; }
+    size_t getPooledObjects() const { return m_pooled_objects; }
+    size_t getCreatedObjects() const { return m_created_objects; }
+
+    private:
+    enum class ChunkState { Unloaded, Loading, Active };
+
+    struct Chunk
+    {
+        int x;
+        int z;
+        ChunkState state = ChunkState::Unloaded;
+        std::vector<uint32_t> placements;
+        std::vector<std::shared_ptr<Obstacle>> objects;     // objects[i] es placements[i]
+    };
+
+    std::shared_ptr<Engine::Scene> m_scene;
+    StreamingSettings m_settings;
+    LevelFile m_file;
+    std::vector<std::shared_ptr<const Prefab>> m_prefabs;
+
+    std::unordered_map<uint64_t, Chunk> m_chunks;
+    std::vector<Chunk*> m_resident;     // Cargando o activos
+    std::vector<Chunk*> m_loading;      // El siguiente a cargar al final
+    std::vector<Chunk*> m_restoring;    // Chunks del snapshot que se está restaurando
+
+    // Un pool por (prefab, override que no se puede volver a aplicar), creado con su primer objeto
+    std::unordered_map<uint64_t, std::unique_ptr<ObjectPool>> m_pools;
+    std::unordered_map<uint64_t, size_t> m_pool_sizes;  // Colocaciones de cada pool en todo el nivel
+
+    bool m_has_cell{false};
+    int m_cell_x{0};
+    int m_cell_z{0};
+
+    size_t m_active_objects{0};
+    size_t m_pooled_objects{0};
+    size_t m_created_objects{0};
+
+    int cell(float v) const;
+    static uint64_t chunkKey(int x, int z);
+    uint64_t poolKey(const LevelFormat::Placement& place) const;
+    float distance(const Chunk& chunk, const glm::vec3& player) const;
+
+    void refresh(const glm::vec3& player);
+    void queue(Chunk& chunk);
+    void load(unsigned budget);
+    void unload(Chunk& chunk);
+
+    ObjectPool& pool(const LevelFormat::Placement& place);
+    std::shared_ptr<Obstacle> acquire(const LevelFormat::Placement& place, unsigned& budget);
+    void activate(Chunk& chunk);
+};
+
+// Avanza el LevelStreamer con la posición del GameObject al que pertenece
+class LevelStreamerClock : public Engine::ScriptComponent
+{
+    std::shared_ptr<LevelStreamer> streamer;
+
+    public:
+    explicit LevelStreamerClock(std::shared_ptr<LevelStreamer> streamer);
+
+    protected:
+    void OnUpdate(const GLfloat& dt) override;
+};
+
+
+#endif // LEVEL_STREAMER_HPP
@@ -0,0 +1,200 @@
+#ifndef LOG_HPP
+#define LOG_HPP
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+
+enum class LogLevel : int { Trace = 0, Debug, Info, Warn, Error, Off };
+
+// Nivel mínimo compilado: por debajo las macros desaparecen (0 = Trace ... 4 = Error)
+#ifndef GAME_LOG_LEVEL
+    #ifdef NDEBUG
+        #define GAME_LOG_LEVEL 2
+    #else
+        #define GAME_LOG_LEVEL 0
+    #endif
+#endif
+
+/**
+ * Categoría de log con su propio nivel en tiempo de ejecución.
+ *
+ * Se declara una por módulo (static) y se registra sola en Log, que puede
+ * cambiar su nivel por nombre. Comprobar si un mensaje pasa el filtro es una
+ * lectura atómica.
+ */
+class LogCategory
+{
+    public:
+    explicit LogCategory(const char* name);
+
+    const char* getName() const { return m_name; }
+
+    bool enabled(LogLevel level) const { return int(level) >= m_level.load(std::memory_order_relaxed); }
+    void setLevel(LogLevel level) { m_level.store(int(level), std::memory_order_relaxed); }
+
+    private:
+    const char* m_name;
+    std::atomic<int> m_level;
+};
+
+/**
+ * Log asíncrono.
+ *
+ * Las macros LOG_* no formatean nada en el hilo que escribe: copian los
+ * argumentos (deben ser trivialmente copiables: números, vectores, literales)
+ * en un registro de tamaño fijo de una cola lock-free con varios productores,
+ * junto con un puntero a la función que sabe formatearlos. Un hilo de fondo
+ * vacía la cola y escribe en la salida. Si la cola está llena el mensaje se
+ * descarta y se cuenta, nunca se bloquea.
+ *
+ * Los niveles por debajo de GAME_LOG_LEVEL no llegan a compilarse, y los que
+ * sí se compilan se filtran por categoría con configure("Enemy=debug,...").
+ */
+class Log
+{
+    public:
+    static constexpr size_t Capacity = 4096;    // Registros en la cola (potencia de dos)
+    static constexpr size_t ArgBytes = 64;      // Espacio para los argumentos de un mensaje
+
+    static Log& Get();
+
+    // "nivel" o "Categoria=nivel" separados por comas; niveles trace, debug, info, warn, error, off
+    void configure(const std::string& spec);
+    void setLevel(const std::string& category, LogLevel level);
+
+    void setOutput(std::ostream* out);
+
+    // Vacía la cola y para el hilo de fondo; los mensajes posteriores se descartan
+    void shutdown();
+
+    uint64_t getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    template<typename... Args>
+    void write(const LogCategory& category, LogLevel level, const char* message, const Args&... args)
+    {
+        using Pack = std::tuple<Args...>;
+        static_assert(sizeof(Pack) <= ArgBytes, "Demasiados argumentos para un mensaje de log");
+        static_assert(alignof(Pack) <= 16, "Alineación de argumentos no soportada");
+        static_assert((std::is_trivially_copyable<Args>::value && ...), "Los argumentos de log deben ser trivialmente copiables");
+
+        uint64_t pos;
+        Cell* cell = claim(pos);
+        if(!cell)
+            return;
+
+        Record* record = &cell->record;
+        record->category = &category;
+        record->level = level;
+        record->message = message;
+        record->time = Clock::now();
+        record->format = &formatPack<Args...>;
+        new (record->args) Pack(args...);
+
+        cell->sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    private:
+    using Clock = std::chrono::steady_clock;
+    using Format = void(*)(std::ostream&, const unsigned char*);
+
+    struct Record
+    {
+        const LogCategory* category;
+        LogLevel level;
+        const char* message;
+        Clock::time_point time;
+        Format format;
+        alignas(16) unsigned char args[ArgBytes];
+    };
+
+    struct Cell
+    {
+        std::atomic<uint64_t> sequence;
+        Record record;
+    };
+
+    Log();
+    ~Log();
+
+    Log(const Log&) = delete;
+    Log& operator=(const Log&) = delete;
+
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(64) std::atomic<uint64_t> m_enqueue{0};
+    alignas(64) uint64_t m_dequeue{0};
+
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+
+    std::mutex m_mutex;     // Sólo registro de categorías y configuración, nunca al escribir
+    std::unordered_map<std::string, LogCategory*> m_categories;
+    std::unordered_map<std::string, LogLevel> m_levels;
+    LogLevel m_default_level{LogLevel::Info};
+    std::ostream* m_out;
+
+    Clock::time_point m_start;
+
+    friend class LogCategory;
+    void registerCategory(LogCategory& category);
+
+    Cell* claim(uint64_t& pos);
+    bool drain();
+    void run();
+
+    template<typename... Args>
+    static void formatPack(std::ostream& out, const unsigned char* data)
+    {
+        const auto& pack = *reinterpret_cast<const std::tuple<Args...>*>(data);
+        std::apply([&out](const auto&... values) { ((out << ' ' << values), ...); }, pack);
+    }
+};
+
+
+#define GAME_LOG_AT(level, category, ...) \
+    do { if((category).enabled(level)) Log::Get().write((category), (level), __VA_ARGS__); } while(0)
+
+#if GAME_LOG_LEVEL <= 0
+    #define LOG_TRACE(category, ...) GAME_LOG_AT(LogLevel::Trace, category, __VA_ARGS__)
+#else
+    #define LOG_TRACE(category, ...) ((void)0)
+#endif
+
+#if GAME_LOG_LEVEL <= 1
+    #define LOG_DEBUG(category, ...) GAME_LOG_AT(LogLevel::Debug, category, __VA_ARGS__)
+#else
+    #define LOG_DEBUG(category, ...) ((void)0)
+#endif
+
+#if GAME_LOG_LEVEL <= 2
+    #define LOG_INFO(category, ...) GAME_LOG_AT(LogLevel::Info, category, __VA_ARGS__)
+#else
+    #define LOG_INFO(category, ...) ((void)0)
+#endif
+
+#if GAME_LOG_LEVEL <= 3
+    #define LOG_WARN(category, ...) GAME_LOG_AT(LogLevel::Warn, category, __VA_ARGS__)
+#else
+    #define LOG_WARN(category, ...) ((void)0)
+#endif
+
+#if GAME_LOG_LEVEL <= 4
+    #define LOG_ERROR(category, ...) GAME_LOG_AT(LogLevel::Error, category, __VA_ARGS__)
+#else
+    #define LOG_ERROR(category, ...) ((void)0)
+#endif
+
+
+#endif // LOG_HPP
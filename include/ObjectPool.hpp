@@ -0,0 +1,126 @@
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <GLS/Scene.hpp>
+
+#include "CollisionLayers.hpp"
+#include "Prefab.hpp"
+#include "Snapshotable.hpp"
+#include "Streamable.hpp"
+
+
+struct PoolSettings
+{
+    size_t prewarm = 16;    // Instancias que se crean al construir el pool
+    size_t max = 64;        // Si se agota crece hasta aquí (prewarm = max: nunca reserva en juego)
+    bool warn_on_grow = true;   // false si crecer bajo demanda es lo esperado (LevelStreamer)
+};
+
+/**
+ * Pool de instancias de un prefab para objetos que aparecen y desaparecen a
+ * menudo (proyectiles, enemigos...).
+ *
+ * La escena no puede destruir GameObjects y cada cloneGameObject() reserva
+ * objeto, componentes, cuerpo y registros en el Listener, así que todas las
+ * instancias se crean al construir el pool y después sólo se reciclan:
+ * acquire() y release() no reservan memoria mientras no haga falta crecer.
+ *
+ * Una instancia libre no sale de la simulación: se oculta, su cuerpo se
+ * desactiva y pasa a la capa CollisionLayers::Parked, que no colisiona con
+ * nada, así que sigue en la broadphase y volver a usarla no la quita ni la
+ * vuelve a añadir. Los scripts Streamable reciben OnStreamOut() al liberarse y
+ * OnStreamIn() al reutilizarse.
+ *
+ * reserve() coloca una instancia pero la deja aparcada hasta show(), para que
+ * LevelStreamer muestre un chunk entero de una vez; acquire() hace las dos cosas.
+ * Un pool con overrides crea todas sus instancias con ellos.
+ */
+class ObjectPool
+{
+    public:
+    ObjectPool(
+        std::shared_ptr<Engine::Scene> scene,
+        std::shared_ptr<const Prefab> prefab,
+        const PoolSettings& settings = {},
+        const PrefabOverrides* overrides = nullptr
+    );
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Con la rotación del prefab; nullptr si está agotado y no puede crecer
+    std::shared_ptr<Obstacle> acquire(const glm::vec3& pos);
+    std::shared_ptr<Obstacle> acquire(const glm::vec3& pos, const glm::quat& rotation);
+
+    // Colocada pero oculta y aparcada hasta show()
+    std::shared_ptr<Obstacle> reserve(const glm::vec3& pos, const glm::quat& rotation);
+    void show(const std::shared_ptr<Obstacle>& obstacle);
+
+    // Vuelve a aparcar una instancia sin liberarla; show() la recupera
+    void hide(const std::shared_ptr<Obstacle>& obstacle);
+
+    void release(const std::shared_ptr<Obstacle>& obstacle);
+    void releaseAll();
+
+    // Estado de una instancia colocada para SceneSnapshot: visible o aparcada,
+    // transform, cuerpo y scripts Snapshotable. Al restaurar la instancia se
+    // reinicia como al volver a un chunk y después recibe lo capturado.
+    void saveState(const std::shared_ptr<Obstacle>& obstacle, JPH::StateRecorder& stream) const;
+    void restoreState(const std::shared_ptr<Obstacle>& obstacle, JPH::StateRecorder& stream);
+
+    const Prefab& getPrefab() const { return *m_prefab; }
+
+    size_t getCapacity() const { return m_slots.size(); }
+    size_t getFree() const { return m_free.size(); }
+    size_t getActive() const { return m_slots.size() - m_free.size(); }
+
+    // Instancias creadas después de prewarm y peticiones sin instancia libre
+    size_t getGrown() const { return m_grown; }
+    size_t getExhausted() const { return m_exhausted; }
+
+    private:
+    enum class SlotState { Free, Reserved, Active };
+
+    struct Slot
+    {
+        std::shared_ptr<Obstacle> obstacle;
+        std::vector<Streamable*> streamables;   // Se buscan una vez al crear la instancia
+        std::vector<Snapshotable*> snapshotables;
+        SlotState state = SlotState::Free;
+    };
+
+    std::shared_ptr<Engine::Scene> m_scene;
+    std::shared_ptr<const Prefab> m_prefab;
+    size_t m_max;
+    bool m_warn_on_grow;
+
+    bool m_modified;
+    PrefabOverrides m_overrides;
+
+    glm::quat m_rotation;
+    CollisionLayers::Layer m_layer;
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_free;
+    std::unordered_map<const Obstacle*, uint32_t> m_index;
+
+    size_t m_grown{0};
+    size_t m_exhausted{0};
+
+    bool grow();
+    Slot* take(const glm::vec3& pos, const glm::quat& rotation);
+    Slot* find(const std::shared_ptr<Obstacle>& obstacle);
+    const Slot* find(const std::shared_ptr<Obstacle>& obstacle) const;
+    void unpark(Slot& slot);
+    void park(Slot& slot);
+};
+
+
+#endif // OBJECT_POOL_HPP
@@ -2,7 +2,6 @@
 #define OBSTACLE_H
 #include <memory>
 #include <string>
-#include <variant>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -12,12 +11,10 @@
 #include <GLS/Listener.hpp>
 
 #include "inputManager.hpp"
+#include "ScriptRegistry.hpp"
 
 class Level;
-
-using scriptParams = std::vector<
-std::variant< std::string, float, int, bool*, inputManager*, Engine::GameObject*>
->;
+class CharacterController;
 
 struct ObstacleSettings
 {
@@ -30,11 +27,17 @@ struct ObstacleSettings
     Engine::Listener::Callback onContactStart = nullptr;
     Engine::Listener::Callback onContactEnd = nullptr;
     unsigned user_index{0};
+    // Si está definido, los contactos con el jugador se registran en su controlador
+    std::shared_ptr<CharacterController> character = nullptr;
+    // Capa de colisión (CollisionLayers), si está vacía se usa el tag del obstáculo
+    std::string layer = "";
+    // Sensor: sin respuesta de colisión, onContactStart/End se disparan al entrar/salir
+    bool sensor = false;
     glm::vec3 scale = {1.f, 1.f, 1.f};
     glm::vec3 axis = {0.f, 1.f, 0.f};
     float angle = 0.f;
-    std::string script = "";
-    scriptParams script_params;
+    // Script tipado, p. ej. ScriptSpec::make<Enemy>({-3.f, 3.f, 2.f})
+    ScriptSpec script;
 };
 
 class Obstacle: public std::enable_shared_from_this<Obstacle>
@@ -63,7 +66,7 @@ class Obstacle: public std::enable_shared_from_this<Obstacle>
         const std::string& filename,
         const std::string& tag,
         const glm::vec3& pos,
-        ObstacleSettings settings
+        const ObstacleSettings& settings
     );
 
 
@@ -72,10 +75,11 @@ class Obstacle: public std::enable_shared_from_this<Obstacle>
         unsigned index_ref,
         const std::string& tag,
         const glm::vec3& pos,
-        ObstacleSettings settings
+        const ObstacleSettings& settings
     );
 
-    
+    const std::shared_ptr<Engine::GameObject>& getObject() const;
+    unsigned getIndex() const { return m_index; }
 
 };
 
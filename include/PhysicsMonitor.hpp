@@ -0,0 +1,118 @@
+#ifndef PHYSICS_MONITOR_HPP
+#define PHYSICS_MONITOR_HPP
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/ContactListener.h>
+#include <Jolt/Physics/PhysicsStepListener.h>
+
+#include <GLS/ScriptComponent.hpp>
+
+
+struct PhysicsStats
+{
+    unsigned validated_pairs = 0;    // Llamadas a OnContactValidate: pares que llegan a la narrowphase
+    unsigned contact_callbacks = 0;  // OnContactAdded + OnContactPersisted, uno por manifold (no son las restricciones)
+    unsigned islands = 0;            // De los cuerpos dinámicos activos
+    unsigned bodies = 0;
+    unsigned active_bodies = 0;
+    unsigned max_bodies = 0;
+    float step_to_update = 0.f;      // Ms desde el inicio del paso hasta OnUpdate (cota superior del paso)
+};
+
+/**
+ * Estadísticas por paso del PhysicsSystem.
+ *
+ * Se coloca delante del ContactListener actual (reenvía todos los eventos) y se
+ * registra como PhysicsStepListener para marcar el inicio del paso. Se adjunta
+ * como script a cualquier GameObject: el motor actualiza los scripts después del
+ * paso físico, así que OnUpdate cierra las estadísticas del paso.
+ *
+ * Jolt no expone las islas, así que se calculan uniendo los pares de cuerpos
+ * dinámicos en contacto (no se tienen en cuenta las restricciones) y partiendo
+ * de los cuerpos dinámicos activos: los cinemáticos no forman parte de ninguna. Los pares
+ * se apuntan desde los hilos de Jolt en un array fijo con un índice atómico,
+ * sin bloqueos; si se llena, las islas del paso son aproximadas.
+ *
+ * El paso sólo avisa al empezar, así que step_to_update incluye lo que haga el
+ * motor entre el final del paso y los scripts.
+ *
+ * Los contactos se comparan con el presupuesto de PhysicsSetup; si no se ha
+ * aplicado, los límites del motor no se conocen y sólo se dan los valores.
+ */
+class PhysicsMonitor : public Engine::ScriptComponent, public JPH::ContactListener, public JPH::PhysicsStepListener
+{
+    public:
+    explicit PhysicsMonitor(float report_interval = 0.f);
+    ~PhysicsMonitor();
+
+    // Estadísticas del último paso y máximos desde el último reset()
+    const PhysicsStats& getStats() const { return m_last; }
+    const PhysicsStats& getPeak() const { return m_peak; }
+    void reset();
+
+    void print(std::ostream& out) const;
+
+    JPH::ValidateResult OnContactValidate(
+        const JPH::Body& inBody1,
+        const JPH::Body& inBody2,
+        JPH::RVec3Arg inBaseOffset,
+        const JPH::CollideShapeResult& inCollisionResult) override;
+
+    void OnContactAdded(
+        const JPH::Body& inBody1,
+        const JPH::Body& inBody2,
+        const JPH::ContactManifold& inManifold,
+        JPH::ContactSettings& ioSettings) override;
+
+    void OnContactPersisted(
+        const JPH::Body& inBody1,
+        const JPH::Body& inBody2,
+        const JPH::ContactManifold& inManifold,
+        JPH::ContactSettings& ioSettings) override;
+
+    void OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) override;
+
+    void OnStep(const JPH::PhysicsStepListenerContext& inContext) override;
+
+    protected:
+    void OnUpdate(const GLfloat& dt) override;
+
+    private:
+    using Clock = std::chrono::steady_clock;
+    using Link = std::pair<uint32_t, uint32_t>;
+
+    static constexpr unsigned MaxLinks = 4096;
+
+    JPH::ContactListener* m_next{nullptr};
+
+    float m_report_interval;
+    float m_report_timer{0.f};
+
+    // Contadores del paso en curso (los callbacks llegan desde varios hilos)
+    std::atomic<unsigned> m_pairs{0};
+    std::atomic<unsigned> m_contacts{0};
+    std::atomic<bool> m_stepped{false};
+    Clock::time_point m_step_start;
+
+    // Sólo se leen en OnUpdate, con el paso ya terminado
+    std::unique_ptr<Link[]> m_links;
+    std::atomic<unsigned> m_link_count{0};
+    std::unordered_map<uint32_t, uint32_t> m_parents;
+
+    PhysicsStats m_last;
+    PhysicsStats m_peak;
+
+    void track(const JPH::Body& body1, const JPH::Body& body2);
+    void collect();
+    unsigned countMerges();
+};
+
+
+#endif // PHYSICS_MONITOR_HPP
@@ -0,0 +1,162 @@
+#ifndef PHYSICS_QUERIES_HPP
+#define PHYSICS_QUERIES_HPP
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Physics/Body/BodyID.h>
+
+#include <glm/glm.hpp>
+
+#include "CollisionLayers.hpp"
+
+
+// Rayo de origin a origin + direction (la longitud va en direction)
+struct RayQuery
+{
+    glm::vec3 origin{0.f, 0.f, 0.f};
+    glm::vec3 direction{0.f, -1.f, 0.f};
+    CollisionLayers::Layer layer = CollisionLayers::Invalid;    // Invalid = choca con todo
+    JPH::BodyID ignore;
+    bool sensors = false;
+};
+
+// Esfera barrida de origin a origin + direction
+struct SphereCastQuery
+{
+    glm::vec3 origin{0.f, 0.f, 0.f};
+    glm::vec3 direction{0.f, -1.f, 0.f};
+    float radius = 0.5f;
+    CollisionLayers::Layer layer = CollisionLayers::Invalid;
+    JPH::BodyID ignore;
+    bool sensors = false;
+};
+
+struct OverlapQuery
+{
+    glm::vec3 center{0.f, 0.f, 0.f};
+    float radius = 0.5f;
+    CollisionLayers::Layer layer = CollisionLayers::Invalid;
+    JPH::BodyID ignore;
+    bool sensors = false;
+};
+
+// Impacto más cercano de un rayo o esfera; body inválido si no ha tocado nada
+struct QueryHit
+{
+    JPH::BodyID body;
+    float fraction = 1.f;
+    glm::vec3 point{0.f, 0.f, 0.f};
+    glm::vec3 normal{0.f, 1.f, 0.f};
+
+    bool hit() const { return !body.IsInvalid(); }
+};
+
+struct OverlapResult
+{
+    static constexpr uint32_t MaxBodies = 8;
+
+    JPH::BodyID bodies[MaxBodies];
+    uint32_t count = 0;
+    bool truncated = false;     // Había más de MaxBodies cuerpos
+};
+
+/**
+ * Consultas por lotes sobre el PhysicsSystem: rayos, esferas barridas y
+ * solapamientos de esfera.
+ *
+ * Cada llamada recibe un array de consultas y escribe un resultado por
+ * consulta, en el mismo índice, en un buffer del llamador (results.size() >=
+ * queries.size()), así que no reserva memoria. Las consultas se reparten en
+ * lotes de BatchSize entre los hilos de un pool pequeño y propio (el JobSystem
+ * del motor es privado), que se crea con la primera consulta que necesita más
+ * de un lote; un lote sólo escribe sus propios resultados. Con menos de un lote
+ * se ejecutan en el hilo que llama. El pool tiene DefaultThreads hilos (nunca
+ * más que núcleos libres) para no competir con los de la física del motor, y
+ * se cambia con setMaxThreads().
+ *
+ * Cada consulta filtra con la matriz de CollisionLayers desde su capa (los
+ * cuerpos aparcados de ObjectPool nunca aparecen), puede ignorar un cuerpo
+ * (el propio personaje, por ejemplo) y por defecto no ve sensores.
+ *
+ * Se llama desde el hilo de juego, fuera de Physics::Step(): los hilos de la
+ * física están parados y los cuerpos no se mueven mientras se consulta.
+ */
+class PhysicsQueries
+{
+    public:
+    static constexpr uint32_t BatchSize = 64;
+    static constexpr int DefaultThreads = 2;
+
+    // Filtro de cuerpos de una consulta: capas, cuerpo ignorado y sensores
+    class Filter : public CollisionLayers::BodyFilter
+    {
+        public:
+        Filter(CollisionLayers::Layer layer, JPH::BodyID ignore, bool sensors);
+
+        bool ShouldCollideLocked(const JPH::Body& inBody) const override;
+
+        private:
+        bool m_sensors;
+    };
+
+    static PhysicsQueries& Get();
+
+    // false (sin hacer nada) si el buffer de resultados es más pequeño que las consultas
+    bool castRays(std::span<const RayQuery> queries, std::span<QueryHit> results);
+    bool castSpheres(std::span<const SphereCastQuery> queries, std::span<QueryHit> results);
+    bool overlapSpheres(std::span<const OverlapQuery> queries, std::span<OverlapResult> results);
+
+    // Hilos del pool de consultas (el hilo que espera también trabaja); 0 = todo en el hilo que llama
+    void setMaxThreads(int threads);
+    int getMaxThreads() const { return m_max_threads; }
+
+    // Reparte [0, count) en rangos de batch entre los hilos del JobSystem y espera
+    template<typename F>
+    void parallelFor(uint32_t count, uint32_t batch, const F& fn)
+    {
+        batch = std::max(batch, 1u);
+        if(count <= batch)
+        {
+            fn(0u, count);
+            return;
+        }
+
+        auto& jobs = getJobSystem();
+        JPH::JobSystem::Barrier* barrier = jobs.CreateBarrier();
+
+        // La captura (puntero y dos uint32_t) cabe en el std::function del trabajo sin reservar
+        for(uint32_t begin = 0; begin < count; begin += batch)
+        {
+            uint32_t end = std::min(begin + batch, count);
+            barrier->AddJob(jobs.CreateJob("PhysicsQueries", JPH::Color::sOrange, [&fn, begin, end]() {
+                fn(begin, end);
+            }));
+        }
+
+        // El hilo que espera también ejecuta lotes
+        jobs.WaitForJobs(barrier);
+        jobs.DestroyBarrier(barrier);
+    }
+
+    private:
+    PhysicsQueries() = default;
+
+    PhysicsQueries(const PhysicsQueries&) = delete;
+    PhysicsQueries& operator=(const PhysicsQueries&) = delete;
+
+    std::unique_ptr<JPH::JobSystemThreadPool> m_jobs;
+    int m_max_threads{DefaultThreads};
+
+    JPH::JobSystem& getJobSystem();
+
+    void castRays(std::span<const RayQuery> queries, std::span<QueryHit> results, uint32_t begin, uint32_t end);
+    void castSpheres(std::span<const SphereCastQuery> queries, std::span<QueryHit> results, uint32_t begin, uint32_t end);
+    void overlapSpheres(std::span<const OverlapQuery> queries, std::span<OverlapResult> results, uint32_t begin, uint32_t end);
+};
+
+
+#endif // PHYSICS_QUERIES_HPP
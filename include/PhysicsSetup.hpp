@@ -0,0 +1,51 @@
+#ifndef PHYSICS_SETUP_HPP
+#define PHYSICS_SETUP_HPP
+
+
+// Límites del PhysicsSystem
+struct PhysicsBudget
+{
+    unsigned max_bodies = 1024;
+    unsigned num_body_mutexes = 0;              // 0 = valor por defecto de Jolt
+    unsigned max_body_pairs = 1024;             // Pares de la broadphase por paso
+    unsigned max_contact_constraints = 1024;    // Restricciones de contacto por paso
+};
+
+/**
+ * Presupuesto del PhysicsSystem del motor.
+ *
+ * Physics::Init() del motor precompilado crea el PhysicsSystem con sus propios
+ * límites. Apply() lo reconstruye en el mismo objeto (destructor y construcción
+ * en la misma dirección, así que el puntero que guarda el motor sigue valiendo)
+ * y lo inicializa con el presupuesto y las capas de CollisionLayers,
+ * conservando listeners, gravedad y ajustes. Sólo se puede hacer justo después
+ * de Physics::Init(), antes de crear ningún cuerpo: si ya hay cuerpos no toca
+ * nada.
+ *
+ * El TempAllocator y el JobSystem con los que el motor avanza la simulación son
+ * privados y se usan dentro de Physics::Step(), así que su tamaño, su número de
+ * hilos y el pico de memoria temporal no se pueden configurar ni leer desde el
+ * juego.
+ */
+class PhysicsSetup
+{
+    public:
+    static PhysicsSetup& Get();
+
+    bool Apply(const PhysicsBudget& budget);
+
+    // Presupuesto aplicado, nullptr si el sistema sigue con los límites del motor
+    const PhysicsBudget* getBudget() const { return m_applied ? &m_budget : nullptr; }
+
+    private:
+    PhysicsSetup() = default;
+
+    PhysicsSetup(const PhysicsSetup&) = delete;
+    PhysicsSetup& operator=(const PhysicsSetup&) = delete;
+
+    PhysicsBudget m_budget;
+    bool m_applied{false};
+};
+
+
+#endif // PHYSICS_SETUP_HPP
@@ -0,0 +1,98 @@
+#ifndef PREFAB_HPP
+#define PREFAB_HPP
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+#include <GLS/Scene.hpp>
+
+#include "Obstacle.hpp"
+
+
+// Cambios de una instancia respecto a su prefab; sólo cuentan los campos marcados
+struct PrefabOverrides
+{
+    enum Field : uint32_t
+    {
+        Scale = 1 << 0,
+        Rotation = 1 << 1,      // axis + angle
+        Script = 1 << 2,        // Mismo script que el prefab con otros parámetros
+    };
+
+    uint32_t fields = 0;
+    glm::vec3 scale{1.f, 1.f, 1.f};
+    glm::vec3 axis{0.f, 1.f, 0.f};
+    float angle = 0.f;
+    ScriptSpec script;
+};
+
+/**
+ * Datos compartidos e inmutables de un tipo de obstáculo: modelo, tag, forma,
+ * cuerpo, script y parámetros por defecto. Las instancias sólo guardan su
+ * posición y, si acaso, unos PrefabOverrides.
+ */
+class Prefab
+{
+    public:
+    Prefab(std::string name, std::string model, std::string tag, ObstacleSettings settings);
+
+    const std::string& getName() const { return m_name; }
+    const std::string& getModel() const { return m_model; }
+    const std::string& getTag() const { return m_tag; }
+    const ObstacleSettings& getSettings() const { return m_settings; }
+
+    private:
+    const std::string m_name;
+    const std::string m_model;
+    const std::string m_tag;
+    const ObstacleSettings m_settings;
+};
+
+/**
+ * Prefabs por nombre, compartidos entre niveles.
+ *
+ * La primera vez que se instancia un prefab en una escena se crea su plantilla:
+ * un GameObject oculto, con el modelo cargado y el cuerpo fuera de la simulación,
+ * sin script ni callbacks. Cada instancia es un cloneGameObject() de la plantilla
+ * (el modelo no se vuelve a cargar) al que se le aplican la posición, los
+ * overrides y los ajustes del prefab por referencia: sólo las instancias con
+ * overrides copian ObstacleSettings.
+ */
+class PrefabLibrary
+{
+    public:
+    static PrefabLibrary& Get();
+
+    // Si ya hay un prefab con ese nombre se devuelve el existente
+    std::shared_ptr<const Prefab> add(std::shared_ptr<const Prefab> prefab);
+    std::shared_ptr<const Prefab> find(const std::string& name) const;
+    size_t size() const { return m_prefabs.size(); }
+
+    std::shared_ptr<Obstacle> instantiate(
+        const std::shared_ptr<Engine::Scene>& scene,
+        const Prefab& prefab,
+        const glm::vec3& pos,
+        const PrefabOverrides* overrides = nullptr
+    );
+
+    // Olvida las plantillas de una escena que se va a destruir
+    void releaseScene(const Engine::Scene* scene);
+
+    private:
+    PrefabLibrary() = default;
+
+    PrefabLibrary(const PrefabLibrary&) = delete;
+    PrefabLibrary& operator=(const PrefabLibrary&) = delete;
+
+    std::unordered_map<std::string, std::shared_ptr<const Prefab>> m_prefabs;
+    std::map<std::pair<const Engine::Scene*, const Prefab*>, unsigned> m_templates;
+
+    unsigned getTemplate(const std::shared_ptr<Engine::Scene>& scene, const Prefab& prefab);
+};
+
+
+#endif // PREFAB_HPP
@@ -0,0 +1,148 @@
+#ifndef PROJECTILE_SYSTEM_HPP
+#define PROJECTILE_SYSTEM_HPP
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+
+#include <glm/glm.hpp>
+
+#include <GLS/ScriptComponent.hpp>
+
+#include "CollisionLayers.hpp"
+
+class ObjectPool;
+class Obstacle;
+
+struct ProjectileSettings
+{
+    size_t capacity = 4096;         // Proyectiles vivos a la vez, todo se reserva en el constructor
+    float lifetime = 3.f;           // Segundos hasta desaparecer sin impactar
+    float gravity_scale = 0.f;      // 0 = trayectoria recta, 1 = caen como los cuerpos
+    float impulse = 0.05f;          // Impulso por unidad de velocidad sobre cuerpos dinámicos
+    size_t batch_size = 256;        // Rayos por trabajo del JobSystem
+    std::string layer = "bullet";   // Capa en CollisionLayers
+};
+
+struct ProjectileHit
+{
+    JPH::BodyID body;
+    JPH::BodyID owner;
+    glm::vec3 point;
+    glm::vec3 normal;
+    glm::vec3 velocity;
+};
+
+/**
+ * Proyectiles sin GameObjects ni cuerpos de Jolt.
+ *
+ * Cada proyectil es un índice en arrays contiguos (posición, velocidad, vida,
+ * dueño...) que se recorren de cuatro en cuatro con JPH::Vec4, así que miles de
+ * proyectiles son unos pocos recorridos lineales por paso. Los muertos se
+ * compactan moviendo el último a su hueco.
+ *
+ * La colisión es continua: en cada paso se lanza un rayo de la posición
+ * anterior a la nueva con NarrowPhaseQuery::CastRay, así que no atraviesan
+ * nada aunque vayan rápido. Los rayos se reparten en lotes de batch_size entre
+ * los hilos del JobSystem de PhysicsQueries; cada lote sólo escribe los resultados
+ * de sus propios índices (PhysicsQueries::parallelFor). Los sensores se
+ * ignoran, el resto de cuerpos se filtra con la matriz de CollisionLayers.
+ *
+ * Los impactos no se notifican desde los hilos: se guardan y se despachan al
+ * final de update() (impulso, CoroutineScheduler::notifyContact y el callback
+ * de setOnHit), cuando ya no se está recorriendo ningún array.
+ *
+ * No dibuja nada: ProjectileView muestra los proyectiles con un ObjectPool.
+ */
+class ProjectileSystem
+{
+    public:
+    using HitCallback = std::function<void(const ProjectileHit&)>;
+
+    explicit ProjectileSystem(const ProjectileSettings& settings = {});
+
+    ProjectileSystem(const ProjectileSystem&) = delete;
+    ProjectileSystem& operator=(const ProjectileSystem&) = delete;
+
+    // false si no queda sitio; owner es el cuerpo que dispara (sus rayos lo ignoran)
+    bool spawn(const glm::vec3& pos, const glm::vec3& velocity, JPH::BodyID owner = JPH::BodyID());
+
+    // Un paso de simulación, con el dt de la física
+    void update(float dt);
+    void clear();
+
+    void setOnHit(HitCallback callback);
+
+    size_t size() const { return m_count; }
+    size_t getCapacity() const { return m_settings.capacity; }
+    glm::vec3 getPosition(size_t index) const { return {m_px[index], m_py[index], m_pz[index]}; }
+
+    uint64_t getHits() const { return m_hits; }
+    uint64_t getDropped() const { return m_dropped; }
+
+    private:
+    ProjectileSettings m_settings;
+    CollisionLayers::Layer m_layer;
+    size_t m_count{0};
+
+    // SoA con el tamaño redondeado a múltiplo de 4 (un Vec4 por grupo)
+    std::vector<float> m_px, m_py, m_pz;
+    std::vector<float> m_vx, m_vy, m_vz;
+    std::vector<float> m_dx, m_dy, m_dz;    // Desplazamiento de este paso (el rayo)
+    std::vector<float> m_life;
+    std::vector<JPH::BodyID> m_owner;
+
+    // Resultado de los rayos del paso, lo escribe el lote al que pertenece el índice
+    std::vector<JPH::BodyID> m_hit_body;
+    std::vector<glm::vec3> m_hit_point;
+    std::vector<glm::vec3> m_hit_normal;
+
+    std::vector<ProjectileHit> m_events;
+    std::vector<ProjectileHit> m_dispatching;
+    HitCallback m_on_hit;
+
+    uint64_t m_hits{0};
+    uint64_t m_dropped{0};
+
+    void integrate(float dt);
+    void castRays();
+    void castRays(size_t begin, size_t end);
+    void advance();
+    void retire();
+    void dispatch();
+
+    void remove(size_t index);
+};
+
+// Avanza un ProjectileSystem con el paso de la física
+class ProjectileClock : public Engine::ScriptComponent
+{
+    std::shared_ptr<ProjectileSystem> projectiles;
+
+    public:
+    explicit ProjectileClock(std::shared_ptr<ProjectileSystem> projectiles);
+
+    protected:
+    void OnPhysicsUpdate(float dt) override;
+};
+
+// Una instancia del pool (un prefab sin cuerpo) por proyectil vivo, hasta la capacidad del pool
+class ProjectileView : public Engine::ScriptComponent
+{
+    std::shared_ptr<ProjectileSystem> projectiles;
+    std::shared_ptr<ObjectPool> pool;
+    std::vector<std::shared_ptr<Obstacle>> shown;
+
+    public:
+    ProjectileView(std::shared_ptr<ProjectileSystem> projectiles, std::shared_ptr<ObjectPool> pool);
+
+    protected:
+    void OnUpdate(const GLfloat& dt) override;
+};
+
+
+#endif // PROJECTILE_SYSTEM_HPP
@@ -0,0 +1,91 @@
+#ifndef SCENE_SNAPSHOT_HPP
+#define SCENE_SNAPSHOT_HPP
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/StateRecorder.h>
+
+#include <GLS/GameObject.hpp>
+
+#include "Snapshotable.hpp"
+
+/**
+ * StateRecorder sobre un buffer contiguo. Al volver a capturar se reutiliza la
+ * memoria, así que capturar y restaurar no reserva memoria en estado estable.
+ */
+class SnapshotRecorder final : public JPH::StateRecorder
+{
+    public:
+    void WriteBytes(const void* inData, size_t inNumBytes) override;
+    void ReadBytes(void* outData, size_t inNumBytes) override;
+    bool IsEOF() const override { return m_cursor >= m_data.size(); }
+    bool IsFailed() const override { return m_failed; }
+
+    void Rewind();
+    void Clear();
+    size_t size() const { return m_data.size(); }
+
+    private:
+    std::vector<uint8_t> m_data;
+    size_t m_cursor{0};
+    bool m_failed{false};
+};
+
+/**
+ * Snapshot de la escena: transform y estado de Jolt del cuerpo de cada
+ * GameObject registrado, el estado de sus scripts Snapshotable y el de los
+ * sistemas registrados con track(Snapshotable). No toca assets: restaurar sólo
+ * copia memoria, así que reiniciar el nivel o reaparecer en un checkpoint es
+ * inmediato.
+ *
+ * Los cuerpos se guardan uno a uno (PhysicsSystem::SaveBodyState), no el
+ * sistema entero: los objetos de LevelStreamer vienen de pools que crecen y se
+ * reutilizan en otras colocaciones, así que el streamer guarda sus chunks
+ * cargados como un Snapshotable más y al restaurar vuelve a colocar cada
+ * instancia. La caché de contactos se vacía al restaurar y se olvidan los
+ * solapamientos de Triggers; los scripts que guardan el estado de un trigger lo
+ * limpian en RestoreState.
+ *
+ * Se captura y restaura desde el hilo de juego, fuera de Physics::Step().
+ */
+class SceneSnapshot
+{
+    public:
+    SceneSnapshot() = default;
+
+    // Registra un GameObject fijo; sus scripts Snapshotable se buscan en este momento
+    void track(const std::shared_ptr<Engine::GameObject>& object);
+
+    // Registra un sistema con estado propio (LevelStreamer), se restaura después de los objetos
+    void track(const std::shared_ptr<Snapshotable>& state);
+
+    void capture();
+    bool restore();
+
+    bool isCaptured() const { return m_captured; }
+
+    // Descarta lo capturado (restore() falla hasta volver a capturar)
+    void discard() { m_captured = false; }
+
+    // Transform y cuerpo de un GameObject, sin sus scripts
+    static void SaveObject(const std::shared_ptr<Engine::GameObject>& object, JPH::StateRecorder& stream);
+    static void RestoreObject(const std::shared_ptr<Engine::GameObject>& object, JPH::StateRecorder& stream);
+
+    private:
+    struct Tracked
+    {
+        std::shared_ptr<Engine::GameObject> object;
+        std::vector<std::shared_ptr<Snapshotable>> states;
+    };
+
+    std::vector<Tracked> m_objects;
+    std::vector<std::shared_ptr<Snapshotable>> m_systems;
+    SnapshotRecorder m_physics;
+    SnapshotRecorder m_state;
+    bool m_captured{false};
+};
+
+
+#endif // SCENE_SNAPSHOT_HPP
@@ -0,0 +1,241 @@
+#ifndef SCRIPT_REGISTRY_HPP
+#define SCRIPT_REGISTRY_HPP
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <GLS/ScriptComponent.hpp>
+
+
+using ScriptId = uint32_t;
+constexpr ScriptId InvalidScript = UINT32_MAX;
+
+class ScriptSpec;
+
+enum class ParamType : uint8_t { Float, Int, Bool };
+
+// Valor tipado leído de un fichero, se asigna al campo con el mismo nombre
+struct ParamValue
+{
+    std::string_view name;
+    ParamType type;
+    union
+    {
+        float f;
+        int32_t i;
+    };
+};
+
+/**
+ * Campo de Params que se puede rellenar desde datos (niveles).
+ *
+ * Se declara con ParamField::of<&Params::campo>("nombre"): el tipo esperado sale
+ * del miembro (float, int32_t o bool) y el campo se escribe a través del
+ * puntero a miembro, nunca por desplazamiento en bytes, así que el tipo
+ * declarado y el que se escribe no pueden diferir. makeSpec() rechaza los
+ * valores cuyo tipo no encaja con el del campo.
+ */
+struct ParamField
+{
+    using Writer = void(*)(void* params, const ParamValue& value);
+
+    const char* name;
+    ParamType type;
+    const void* owner;      // Identifica el Params al que pertenece el miembro
+    Writer write;
+
+    template<auto Member>
+    static constexpr ParamField of(const char* name)
+    {
+        using Class = typename MemberOf<decltype(Member)>::Class;
+        return {name, typeOf<typename MemberOf<decltype(Member)>::Type>(), &Owner<Class>, &assign<Member>};
+    }
+
+    // Float admite también enteros; Int y Bool sólo su propio tipo
+    bool accepts(ParamType value) const
+    {
+        return value == type || (type == ParamType::Float && value == ParamType::Int);
+    }
+
+    template<typename P>
+    static constexpr const void* ownerOf() { return &Owner<P>; }
+
+    private:
+    template<typename P>
+    static constexpr char Owner = 0;
+
+    template<typename T>
+    struct MemberOf;
+
+    template<typename C, typename M>
+    struct MemberOf<M C::*>
+    {
+        using Class = C;
+        using Type = M;
+    };
+
+    template<typename T>
+    static constexpr ParamType typeOf()
+    {
+        if constexpr (std::is_same<T, float>::value)
+            return ParamType::Float;
+        else if constexpr (std::is_same<T, int32_t>::value)
+            return ParamType::Int;
+        else if constexpr (std::is_same<T, bool>::value)
+            return ParamType::Bool;
+        else
+            static_assert(sizeof(T) == 0, "Un ParamField sólo puede ser float, int32_t o bool");
+    }
+
+    // accepts() ya ha comprobado el tipo del valor
+    template<auto Member>
+    static void assign(void* params, const ParamValue& value)
+    {
+        using Traits = MemberOf<decltype(Member)>;
+        auto& field = static_cast<typename Traits::Class*>(params)->*Member;
+
+        if constexpr (std::is_same<typename Traits::Type, float>::value)
+            field = value.type == ParamType::Float ? value.f : float(value.i);
+        else if constexpr (std::is_same<typename Traits::Type, bool>::value)
+            field = value.i != 0;
+        else
+            field = value.i;
+    }
+};
+
+/**
+ * Tabla de scripts con IDs internados.
+ *
+ * Cada script declara su nombre (static constexpr const char* Name) y un struct
+ * Params con sus parámetros tipados, y se construye con T(const Params&). El ID
+ * de un tipo se obtiene con id<T>(), que lo registra la primera vez y después es
+ * una variable estática. El nombre sólo se usa para buscar con find() al cargar
+ * datos; crear un script es indexar la tabla y llamar a su fábrica.
+ *
+ * Si el script declara además static constexpr ParamField Fields[] (miembros
+ * de su propio Params, ver ParamField::of), makeSpec() puede construir sus
+ * Params a partir de valores con nombre, que es como los cargan los niveles.
+ */
+class ScriptRegistry
+{
+    public:
+    using Factory = std::shared_ptr<Engine::ScriptComponent>(*)(const void* params);
+    using Defaults = std::shared_ptr<void>(*)();
+
+    static ScriptRegistry& Get();
+
+    template<typename T>
+    static ScriptId id()
+    {
+        static const ScriptId value = Get().add(T::Name, &construct<T>, &defaults<T>, fields<T>());
+        return value;
+    }
+
+    // InvalidScript si no hay ningún script con ese nombre registrado
+    ScriptId find(const std::string& name) const;
+    const std::string& getName(ScriptId id) const;
+    size_t size() const { return m_entries.size(); }
+
+    std::span<const ParamField> getFields(ScriptId id) const;
+
+    // Params por defecto con los valores dados; spec inválido si algún campo no existe o no encaja
+    ScriptSpec makeSpec(ScriptId id, std::span<const ParamValue> values) const;
+
+    // params debe apuntar al Params del script con ese id (ScriptSpec lo garantiza)
+    std::shared_ptr<Engine::ScriptComponent> create(ScriptId id, const void* params) const;
+
+    private:
+    struct Entry
+    {
+        std::string name;
+        Factory factory;
+        Defaults defaults;
+        std::span<const ParamField> fields;
+    };
+
+    ScriptRegistry() = default;
+
+    ScriptRegistry(const ScriptRegistry&) = delete;
+    ScriptRegistry& operator=(const ScriptRegistry&) = delete;
+
+    std::vector<Entry> m_entries;
+    std::unordered_map<std::string, ScriptId> m_ids;
+
+    ScriptId add(const char* name, Factory factory, Defaults defaults, std::span<const ParamField> fields);
+
+    template<typename T>
+    static std::shared_ptr<Engine::ScriptComponent> construct(const void* params)
+    {
+        return std::make_shared<T>(*static_cast<const typename T::Params*>(params));
+    }
+
+    template<typename T>
+    static std::shared_ptr<void> defaults()
+    {
+        return std::make_shared<typename T::Params>();
+    }
+
+    template<typename T>
+    static std::span<const ParamField> fields()
+    {
+        if constexpr (requires { T::Fields; })
+        {
+            static_assert(std::ranges::all_of(T::Fields, [](const ParamField& field) {
+                return field.owner == ParamField::ownerOf<typename T::Params>();
+            }), "Fields debe declarar miembros de T::Params");
+            return T::Fields;
+        }
+        else
+            return {};
+    }
+};
+
+/**
+ * Script a añadir a un objeto: ID y parámetros ya construidos.
+ *
+ * make<T>() comprueba en compilación que T es un script y que se construye con
+ * sus Params. Los parámetros se comparten entre todas las copias del spec, así
+ * que crear miles de instancias no vuelve a copiarlos ni a validarlos.
+ */
+class ScriptSpec
+{
+    public:
+    ScriptSpec() = default;
+
+    template<typename T>
+    static ScriptSpec make(const typename T::Params& params = {})
+    {
+        static_assert(std::is_base_of<Engine::ScriptComponent, T>::value, "T debe heredar de ScriptComponent");
+        static_assert(std::is_constructible<T, const typename T::Params&>::value, "T debe construirse con const T::Params&");
+
+        ScriptSpec spec;
+        spec.m_id = ScriptRegistry::id<T>();
+        spec.m_params = std::make_shared<const typename T::Params>(params);
+        return spec;
+    }
+
+    bool valid() const { return m_id != InvalidScript; }
+    ScriptId getId() const { return m_id; }
+
+    std::shared_ptr<Engine::ScriptComponent> create() const
+    {
+        return valid() ? ScriptRegistry::Get().create(m_id, m_params.get()) : nullptr;
+    }
+
+    private:
+    friend class ScriptRegistry;
+
+    ScriptSpec(ScriptId id, std::shared_ptr<const void> params) : m_id(id), m_params(std::move(params)) {}
+
+    ScriptId m_id{InvalidScript};
+    std::shared_ptr<const void> m_params;
+};
+
+
+#endif // SCRIPT_REGISTRY_HPP
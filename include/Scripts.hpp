@@ -1,62 +1,125 @@
 #ifndef SCRIPTS_HPP
 #define SCRIPTS_HPP
+
 #include <GLS/ScriptComponent.hpp>
+#include <GLS/CameraComponent.hpp>
 #include <GLS/Utils.hpp>
 
 
-#include "Obstacle.hpp"
+#include "Coroutine.hpp"
+#include "ScriptRegistry.hpp"
 #include "inputManager.hpp"
+#include "UpdateLOD.hpp"
+#include "Snapshotable.hpp"
 
-class PlataformaMovil: public Engine::ScriptComponent
+// Va y viene entre min y max; la corrutina sólo despierta en los extremos
+class PlataformaMovil: public CoroutineScript
 {
     float speed = 0.f;
     bool vertical = true;
-    int max{5};
-    int min{0};
+    float max{5.f};
+    float min{0.f};
 
     public:
+    static constexpr const char* Name = "PlataformaMovil";
+
+    struct Params
+    {
+        float min = 0.f;
+        float max = 5.f;
+        bool vertical = true;
+    };
 
-    PlataformaMovil() = default;
+    static constexpr ParamField Fields[] = {
+        ParamField::of<&Params::min>("min"),
+        ParamField::of<&Params::max>("max"),
+        ParamField::of<&Params::vertical>("vertical"),
+    };
 
-    PlataformaMovil(scriptParams params);
+    PlataformaMovil();
+    explicit PlataformaMovil(const Params& params);
 
-    void OnPhysicsUpdate(float dt) override;
+    protected:
+    Behaviour run() override;
 
 };
 
-class Enemy: public Engine::ScriptComponent
+// Patrulla en X entre min y max mirando hacia donde avanza
+class Enemy: public CoroutineScript
 {
 
     float speed = 1.f;
-    int max{5};
-    int min{0};
+    float max{5.f};
+    float min{0.f};
     glm::quat rot_left{};
     glm::quat rot_right{};
 
     public:
+    static constexpr const char* Name = "Enemy";
 
-    Enemy() = default;
+    struct Params
+    {
+        float min = 0.f;
+        float max = 5.f;
+        float speed = 1.f;
+    };
 
-    Enemy(scriptParams params);
+    static constexpr ParamField Fields[] = {
+        ParamField::of<&Params::min>("min"),
+        ParamField::of<&Params::max>("max"),
+        ParamField::of<&Params::speed>("speed"),
+    };
 
-    void OnPhysicsUpdate(float dt) override;
+    Enemy();
+    explicit Enemy(const Params& params);
+
+    protected:
+    Behaviour run() override;
 
 };
 
-class Parachute: public Engine::ScriptComponent
+// Lejos de la cámara se comprueba con menos frecuencia; enganchado, cada frame
+class Parachute: public LODScript, public Streamable, public Snapshotable
 {
     float speed = 5.f;
     bool *is_coll{nullptr};
     inputManager *input{nullptr};
-    Engine::GameObject *user{nullptr};
     glm::vec3 offset{0.f, -2.2f, 0.f};
     bool hooked{false};
+    bool streamed_out{false};
 
     public:
-    Parachute() = default;
-    Parachute(scriptParams params);
-    void OnPhysicsUpdate(float dt) override;
+    static constexpr const char* Name = "Parachute";
+
+    struct Params
+    {
+        bool* is_coll = nullptr;    // Contacto con el sensor del paracaídas
+        inputManager* input = nullptr;
+    };
+
+    explicit Parachute(const Params& params);
+    void OnLODPhysicsUpdate(float dt) override;
+
+    void SaveState(JPH::StateRecorder& stream) const override;
+    void RestoreState(JPH::StateRecorder& stream) override;
+
+    void OnStreamIn() override;
+    void OnStreamOut() override;
 };
 
+// Oído del AudioSystem: sigue al GameObject y mira hacia donde mira la cámara.
+// También avanza el AudioSystem una vez por frame.
+class AudioListener: public Engine::ScriptComponent
+{
+    std::shared_ptr<Engine::CameraComponent> camera;
+
+    public:
+    AudioListener(std::shared_ptr<Engine::CameraComponent> camera);
+    void OnUpdate(const GLfloat& dt) override;
+};
+
+// Registra todos los scripts del juego para poder crearlos por nombre (niveles)
+void RegisterScripts();
+
 
 #endif // SCRIPTS_HPP
\ No newline at end of file
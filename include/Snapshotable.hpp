@@ -0,0 +1,22 @@
+#ifndef SNAPSHOTABLE_HPP
+#define SNAPSHOTABLE_HPP
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/StateRecorder.h>
+
+
+/**
+ * Interfaz para scripts y sistemas con estado propio que debe sobrevivir a un
+ * SceneSnapshot, además del transform y el cuerpo de su GameObject.
+ * RestoreState() lee exactamente lo que escribió SaveState().
+ */
+class Snapshotable
+{
+    public:
+    virtual ~Snapshotable() = default;
+
+    virtual void SaveState(JPH::StateRecorder& stream) const = 0;
+    virtual void RestoreState(JPH::StateRecorder& stream) = 0;
+};
+
+
+#endif // SNAPSHOTABLE_HPP
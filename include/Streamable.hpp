@@ -0,0 +1,22 @@
+#ifndef STREAMABLE_HPP
+#define STREAMABLE_HPP
+
+
+/**
+ * Interfaz para scripts de objetos que gestiona LevelStreamer u ObjectPool. Los
+ * objetos de un chunk que se descarga, o que se devuelven a su pool, no se
+ * destruyen: se ocultan, su cuerpo deja de simular y se reutilizan después en
+ * otro sitio, así que el script debe olvidar su estado al salir y empezar de
+ * cero al volver a entrar.
+ */
+class Streamable
+{
+    public:
+    virtual ~Streamable() = default;
+
+    virtual void OnStreamIn() = 0;
+    virtual void OnStreamOut() = 0;
+};
+
+
+#endif // STREAMABLE_HPP
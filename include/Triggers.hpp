@@ -0,0 +1,131 @@
+#ifndef TRIGGERS_HPP
+#define TRIGGERS_HPP
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Collision/ContactListener.h>
+
+#include <GLS/Body.hpp>
+#include <GLS/Listener.hpp>
+#include <GLS/ScriptComponent.hpp>
+
+/**
+ * Volúmenes de disparo (sensores) para metas, objetos recogibles, zonas, etc.
+ *
+ * Un trigger es un cuerpo de Jolt marcado como sensor: no genera restricciones de
+ * contacto, sólo eventos de solapamiento. Los eventos no pasan por el Listener:
+ * el slot de cada trigger se guarda en una tabla plana indexada por el índice del
+ * BodyID, así que la búsqueda es un acceso a vector sin hashing de pares.
+ *
+ * Los solapamientos llegan por dos caminos. El personaje es virtual y llama a
+ * Enter/Exit desde sus propios contactos. El resto de cuerpos llega por el
+ * ContactListener del sistema (attachContacts), desde los hilos de Jolt: ahí
+ * sólo se apunta el BodyID y dispatch() cuenta y llama a los callbacks en el
+ * hilo de juego (TriggerClock). Jolt sólo empareja un sensor con cuerpos
+ * dinámicos, así que el cuerpo cinemático que sigue al personaje no se cuenta
+ * dos veces.
+ *
+ * Add/Remove se llaman desde el hilo de juego fuera de Physics::Step(): los
+ * hilos de Jolt sólo leen la tabla.
+ */
+class Triggers : public JPH::ContactListener
+{
+    public:
+    using Callback = Engine::Listener::Callback;
+
+    static Triggers& Get();
+
+    // Se coloca delante del ContactListener actual del PhysicsSystem
+    void attachContacts();
+
+    // Aplica los solapamientos que ha notificado el sistema (hilo de juego)
+    void dispatch();
+
+    // Convierte un cuerpo existente en sensor y registra sus eventos de entrada/salida
+    void Add(const std::shared_ptr<Engine::Body>& body, Callback onEnter, Callback onExit = nullptr);
+
+    void Remove(JPH::BodyID id);
+
+    bool IsTrigger(JPH::BodyID id) const;
+
+    // Notifican un solapamiento que empieza/termina. Devuelven false si el cuerpo no es
+    // un trigger. El callback a ejecutar (si lo hay) se devuelve en outCallback.
+    bool Enter(JPH::BodyID id, Callback& outCallback);
+    bool Exit(JPH::BodyID id, Callback& outCallback);
+
+    // Olvida los solapamientos sin llamar a on_exit (al restaurar o reiniciar el nivel)
+    void ResetOverlaps();
+
+    JPH::ValidateResult OnContactValidate(
+        const JPH::Body& inBody1,
+        const JPH::Body& inBody2,
+        JPH::RVec3Arg inBaseOffset,
+        const JPH::CollideShapeResult& inCollisionResult) override;
+
+    void OnContactAdded(
+        const JPH::Body& inBody1,
+        const JPH::Body& inBody2,
+        const JPH::ContactManifold& inManifold,
+        JPH::ContactSettings& ioSettings) override;
+
+    void OnContactPersisted(
+        const JPH::Body& inBody1,
+        const JPH::Body& inBody2,
+        const JPH::ContactManifold& inManifold,
+        JPH::ContactSettings& ioSettings) override;
+
+    void OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) override;
+
+    private:
+    Triggers() = default;
+
+    Triggers(const Triggers&) = delete;
+    Triggers& operator=(const Triggers&) = delete;
+
+    struct Trigger
+    {
+        JPH::BodyID id;
+        Callback on_enter;
+        Callback on_exit;
+        unsigned overlaps{0};
+    };
+
+    // Solapamiento notificado por el sistema, pendiente de dispatch()
+    struct Contact
+    {
+        JPH::BodyID id;
+        bool enter;
+    };
+
+    static constexpr uint32_t NoSlot = ~uint32_t(0);
+
+    JPH::ContactListener* m_next{nullptr};
+    bool m_attached{false};
+
+    std::mutex m_contacts_mutex;
+    std::vector<Contact> m_contacts;
+    std::vector<Contact> m_dispatching;
+
+    std::vector<Trigger> m_triggers;
+    std::vector<uint32_t> m_slots;  // Índice del BodyID -> posición en m_triggers
+    std::vector<uint32_t> m_free;
+
+    Trigger* find(JPH::BodyID id);
+    const Trigger* find(JPH::BodyID id) const;
+
+    // Desde los hilos de Jolt: apunta el contacto si id es un trigger
+    void notify(JPH::BodyID id, bool enter);
+};
+
+// Despacha los solapamientos de Triggers con el paso de la física
+class TriggerClock : public Engine::ScriptComponent
+{
+    protected:
+    void OnPhysicsUpdate(float dt) override;
+};
+
+
+#endif // TRIGGERS_HPP
@@ -0,0 +1,124 @@
+#ifndef UI_DATA_MODEL_HPP
+#define UI_DATA_MODEL_HPP
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/DataModelHandle.h>
+
+
+/**
+ * Valor enlazado a una variable de un data model de RmlUi.
+ *
+ * set() compara con el valor actual y sólo marca la variable como sucia si ha
+ * cambiado: RmlUi actualiza entonces únicamente los elementos que la usan
+ * ({{nombre}}, data-if, data-class...) en el siguiente Update(). Asignar el
+ * mismo valor cada frame no cuesta ni búsquedas, ni strings, ni relayout.
+ * También marca el modelo como cambiado (UIDataModel::consumeChanges()).
+ */
+template<typename T>
+class UIValue
+{
+    public:
+    UIValue(Rml::DataModelHandle handle, std::string name, const T& value, bool* changed = nullptr)
+        : m_handle(handle), m_name(std::move(name)), m_value(value), m_changed(changed) {}
+
+    UIValue(const UIValue&) = delete;
+    UIValue& operator=(const UIValue&) = delete;
+
+    bool set(const T& value)
+    {
+        if(m_value == value)
+            return false;
+
+        m_value = value;
+        m_handle.DirtyVariable(m_name);
+        if(m_changed)
+            *m_changed = true;
+        return true;
+    }
+
+    const T& get() const { return m_value; }
+    const std::string& getName() const { return m_name; }
+
+    // RmlUi lee la variable directamente de aquí, la dirección no puede cambiar
+    T* data() { return &m_value; }
+
+    private:
+    Rml::DataModelHandle m_handle;
+    std::string m_name;
+    T m_value;
+    bool* m_changed;
+};
+
+/**
+ * Data model de RmlUi con variables tipadas (int, float, bool, string...).
+ *
+ * Se crea sobre el contexto antes de cargar los documentos que lo usan
+ * (data-model="nombre"). Las variables viven aquí y RmlUi las lee por puntero,
+ * así que el modelo debe sobrevivir al contexto (o a sus documentos).
+ */
+class UIDataModel
+{
+    public:
+    UIDataModel(Rml::Context* context, const std::string& name);
+
+    UIDataModel(const UIDataModel&) = delete;
+    UIDataModel& operator=(const UIDataModel&) = delete;
+
+    bool isValid() const { return m_valid; }
+    const std::string& getName() const { return m_name; }
+
+    // Registra una variable; nullptr si el modelo no es válido o el nombre ya existe
+    template<typename T>
+    UIValue<T>* bind(const std::string& name, const T& value = T{})
+    {
+        if(!m_valid)
+            return nullptr;
+
+        auto holder = std::make_unique<Holder<T>>(m_handle, name, value, &m_changed);
+        if(!m_constructor.Bind(name, holder->value.data()))
+        {
+            std::cerr << "[UIDataModel] No se pudo enlazar '" << name << "' en '" << m_name << "'" << std::endl;
+            return nullptr;
+        }
+
+        UIValue<T>* result = &holder->value;
+        m_values.push_back(std::move(holder));
+        return result;
+    }
+
+    // Fuerza a RmlUi a refrescar todas las variables (tras cargar un documento, por ejemplo)
+    void dirtyAll();
+
+    // Si alguna variable ha cambiado desde la última llamada
+    bool consumeChanges();
+
+    private:
+    struct HolderBase
+    {
+        virtual ~HolderBase() = default;
+    };
+
+    template<typename T>
+    struct Holder : HolderBase
+    {
+        Holder(Rml::DataModelHandle handle, const std::string& name, const T& value, bool* changed)
+            : value(handle, name, value, changed) {}
+
+        UIValue<T> value;
+    };
+
+    std::string m_name;
+    Rml::DataModelConstructor m_constructor;
+    Rml::DataModelHandle m_handle;
+    bool m_valid{false};
+    bool m_changed{false};
+
+    std::vector<std::unique_ptr<HolderBase>> m_values;
+};
+
+
+#endif // UI_DATA_MODEL_HPP
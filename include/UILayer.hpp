@@ -0,0 +1,68 @@
+#ifndef UI_LAYER_HPP
+#define UI_LAYER_HPP
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <GLS/Renderer.hpp>
+#include <GLS/UIManager.hpp>
+
+
+/**
+ * Capa de UI del juego: muestra y oculta plantillas llevando la cuenta de las
+ * que están visibles.
+ *
+ * El renderer ejecuta Update() y Render() de RmlUi en cada frame mientras tenga
+ * un UIManager asignado, haya o no algo en pantalla. Esta clase sólo se lo
+ * asigna mientras quede alguna plantilla visible, así que durante el juego sin
+ * menús el pase de UI no se ejecuta. Los data models que cambien mientras tanto
+ * se sincronizan en el primer Update() tras volver a mostrarse.
+ *
+ * Con algo visible el motor vuelve a dibujar la UI en cada frame junto con la
+ * escena, así que lo único que se puede ahorrar es el frame entero. Para eso
+ * consumeChanges() dice si lo visible ha cambiado (mostrar, ocultar o un
+ * UIValue::set() de un modelo vigilado); en pausa FramePacer no adelanta el
+ * siguiente frame si no hay cambios ni input.
+ */
+class UIDataModel;
+
+class UILayer
+{
+    public:
+    UILayer(std::shared_ptr<UIManager> ui_manager, std::shared_ptr<Engine::Renderer> renderer);
+
+    UILayer(const UILayer&) = delete;
+    UILayer& operator=(const UILayer&) = delete;
+
+    bool show(const std::string& template_id);
+    bool hide(const std::string& template_id);
+    bool isVisible(const std::string& template_id) const;
+
+    // Ninguna plantilla visible: el renderer no tiene UIManager
+    bool isIdle() const { return m_visible.empty(); }
+
+    // Sus cambios cuentan en consumeChanges(); debe vivir más que la capa
+    void watch(UIDataModel* model);
+
+    // Si lo visible ha cambiado desde la última llamada
+    bool consumeChanges();
+
+    // Desconecta el UIManager del renderer (antes del shutdown de la UI)
+    void detach();
+
+    private:
+    std::shared_ptr<UIManager> m_ui_manager;
+    std::shared_ptr<Engine::Renderer> m_renderer;
+
+    std::unordered_set<std::string> m_visible;
+    std::vector<UIDataModel*> m_models;
+    bool m_attached{false};
+    bool m_detached{false};
+    bool m_changed{false};
+
+    void sync();
+};
+
+
+#endif // UI_LAYER_HPP
@@ -0,0 +1,120 @@
+#ifndef UPDATE_LOD_HPP
+#define UPDATE_LOD_HPP
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include <glm/glm.hpp>
+
+#include <GLS/CameraComponent.hpp>
+#include <GLS/ScriptComponent.hpp>
+
+
+struct LODPolicy
+{
+    float near_distance = 20.f;     // Hasta aquí se actualiza cada frame
+    float far_distance = 60.f;      // Entre near y far cada mid_interval, más allá cada far_interval
+    unsigned mid_interval = 2;
+    unsigned far_interval = 8;
+    unsigned hidden_interval = 8;   // Fuera del frustum (0 = no se actualiza)
+    float radius = 2.f;             // Radio del objeto para la prueba de visibilidad
+};
+
+/**
+ * Frecuencia de actualización por distancia a la cámara activa y visibilidad.
+ *
+ * UpdateLODClock guarda una vez por frame la posición y el frustum de la cámara,
+ * y cada LODScript pregunta con interval() cada cuántos frames le toca. Los
+ * scripts con el mismo intervalo se reparten entre frames con una fase propia
+ * para que el coste no se concentre en uno solo.
+ */
+class UpdateLOD
+{
+    public:
+    static UpdateLOD& Get();
+
+    void setViewer(const glm::mat4& view, const glm::mat4& projection);
+
+    // 1 = cada frame, N = cada N frames, 0 = nunca mientras siga así
+    unsigned interval(const glm::vec3& position, const LODPolicy& policy) const;
+
+    uint64_t getFrame() const { return m_frame; }
+    const glm::vec3& getViewerPosition() const { return m_viewer; }
+
+    // Ticks ejecutados y saltados en el frame anterior (para medir)
+    unsigned getTicked() const { return m_last_ticked; }
+    unsigned getSkipped() const { return m_last_skipped; }
+    void count(bool ticked) { ticked ? ++m_ticked : ++m_skipped; }
+
+    private:
+    UpdateLOD() = default;
+
+    UpdateLOD(const UpdateLOD&) = delete;
+    UpdateLOD& operator=(const UpdateLOD&) = delete;
+
+    bool m_has_viewer{false};
+    glm::vec3 m_viewer{0.f};
+    std::array<glm::vec4, 6> m_planes{};
+    uint64_t m_frame{0};
+
+    unsigned m_ticked{0};
+    unsigned m_skipped{0};
+    unsigned m_last_ticked{0};
+    unsigned m_last_skipped{0};
+};
+
+/**
+ * Script con frecuencia de actualización variable. Las subclases implementan
+ * OnLODUpdate/OnLODPhysicsUpdate, que reciben todo el dt acumulado desde su
+ * último tick, así que la lógica basada en tiempo avanza igual aunque se
+ * ejecute menos veces.
+ */
+class LODScript : public Engine::ScriptComponent
+{
+    public:
+    static constexpr float MaxAccumulated = 1.f;    // Tope de dt acumulado (objetos ocultos)
+
+    void setLODPolicy(const LODPolicy& policy) { m_policy = policy; }
+    const LODPolicy& getLODPolicy() const { return m_policy; }
+    unsigned getLODInterval() const { return m_interval; }
+
+    protected:
+    // Mientras esté activo se actualiza cada frame (p. ej. interactuando con el jugador)
+    void setLODActive(bool active) { m_active = active; }
+
+    LODScript();
+
+    virtual void OnLODUpdate(float) {}
+    virtual void OnLODPhysicsUpdate(float) {}
+
+    void OnUpdate(const GLfloat& dt) final;
+    void OnPhysicsUpdate(float dt) final;
+
+    private:
+    LODPolicy m_policy;
+    unsigned m_phase;
+    unsigned m_interval{1};
+    bool m_tick{true};
+    bool m_active{false};
+    uint64_t m_frame{UINT64_MAX};
+
+    float m_update_dt{0.f};
+    float m_physics_dt{0.f};
+
+    void refresh();
+};
+
+// Publica la cámara activa en UpdateLOD una vez por frame
+class UpdateLODClock : public Engine::ScriptComponent
+{
+    std::shared_ptr<Engine::CameraComponent> camera;
+
+    public:
+    explicit UpdateLODClock(std::shared_ptr<Engine::CameraComponent> camera);
+
+    protected:
+    void OnUpdate(const GLfloat& dt) override;
+};
+
+
+#endif // UPDATE_LOD_HPP
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <random>
@@ -13,6 +15,8 @@
 // Esto es CRUCIAL: Le decimos al compilador "Existen estas clases", 
 // pero no incluimos sus archivos .h pesados aquí.
 class UIManager;
+class CharacterController;
+class FramePacer;
 
 
 class inputManager : public Engine::Input
@@ -21,17 +25,27 @@ private:
     // Atributos del Jugador
     std::shared_ptr<Engine::GameObject> user{nullptr};
     std::shared_ptr<Engine::Scene> scene{nullptr};
+    std::shared_ptr<CharacterController> character{nullptr};
     float sensitivity{0.5f};
-    bool is_jumping {false};
     Engine::Listener::Callback onGameOver;
     Engine::Listener::Callback onPause;
+    Engine::Listener::Callback onFire;
+    std::function<void(double)> onInputConsumed;
     
     const bool &paused {false};
     
     // Estado para detectar transición de ESC (evitar múltiples toggles)
     bool last_esc_state{false};
     bool holing{false};
-    float impulseMagnitude{40.f};
+
+    // Ritmo de frames mientras el juego está en pausa (opcional)
+    std::shared_ptr<FramePacer> pacer{nullptr};
+    bool was_paused{false};
+
+    // Entrada por pasos fijos (InputQueue)
+    double sim_time{0.0};
+    bool jump_held{false};
+    uint8_t move_keys{0};   // WASD pulsadas según la cola
 
     // Atributos de Obstáculos
     
@@ -54,6 +68,10 @@ public:
     // Loop principal
     void update(const float &dt) noexcept;
 
+    // Paso fijo de simulación: consume los eventos de entrada hasta el tiempo del paso
+    // y aplica el movimiento con las teclas que quedan pulsadas
+    void step(float dt) noexcept;
+
     void handle_camera (const float &dt) noexcept;
     void handle_move() noexcept;
 
@@ -61,12 +79,22 @@ public:
 
     void gameOver() noexcept;
 
-    void setJumping(bool) noexcept;
+    void setCharacter(std::shared_ptr<CharacterController> character) noexcept;
+
+    const std::shared_ptr<CharacterController>& getCharacter() const noexcept;
 
     void setOnGameOver(Engine::Listener::Callback callback) noexcept;
 
     void setOnPause(Engine::Listener::Callback callback) noexcept;
 
+    // Disparo (botón derecho), se llama desde el paso fijo que consume la pulsación
+    void setOnFire(Engine::Listener::Callback callback) noexcept;
+
+    // Recibe el tiempo de cada pulsación cuando la consume un paso fijo
+    void setOnInputConsumed(std::function<void(double)> callback) noexcept;
+
+    void setFramePacer(std::shared_ptr<FramePacer> frame_pacer) noexcept;
+
     JPH::Vec3 getForward() const noexcept;
     
     // Manejar pausa con ESC (lógica del juego, no del motor)
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <cstdlib>
 #include <stdexcept>
 #include <random>
 #include <filesystem>
@@ -13,10 +14,12 @@
 
 #include <GLS/Window.hpp>
 #include "GLS/Physics.hpp"
-#include "GLS/AudioManager.hpp"
 #include "GLS/Path.hpp"
 
 #include "Game.hpp"
+#include "AudioSystem.hpp"
+#include "Log.hpp"
+#include "PhysicsSetup.hpp"
 
 
 using namespace Engine;
@@ -26,8 +29,24 @@ int main()
     try
     {
         
+        // GAME_LOG: niveles por categoría, p. ej. "warn,Enemy=debug,PlataformaMovil=off"
+        if(const char* log_spec = std::getenv("GAME_LOG"))
+            Log::Get().configure(log_spec);
+
         Engine::Physics::Get().Init();
-        Engine::AudioManager::Get().init();
+
+        // Límites de la simulación, antes de crear ningún cuerpo. PhysicsMonitor
+        // informa de lo cerca que estamos
+        PhysicsBudget physics_budget;
+        physics_budget.max_bodies = 4096;
+        physics_budget.max_body_pairs = 4096;
+        physics_budget.max_contact_constraints = 2048;
+        PhysicsSetup::Get().Apply(physics_budget);
+
+        // GAME_NULL_AUDIO: sin dispositivo de sonido, la mezcla la hace el bucle de juego
+        AudioSettings audio_settings;
+        audio_settings.offline = std::getenv("GAME_NULL_AUDIO") != nullptr;
+        AudioSystem::Get().init(audio_settings);
 
         // Window dimensions
         constexpr GLint WIDTH = 1200;
@@ -48,6 +67,8 @@ int main()
 
         Game game(main_window);
         game.init();
+        game.enablePhysicsStats(5.f);
+        game.enableLatencyStats(5.f);
 
         game.Level1();
         
@@ -60,7 +81,8 @@ int main()
         game.shutdownUI();
         
         Engine::Physics::Get().Shutdown();
-        Engine::AudioManager::Get().shutdown();
+        AudioSystem::Get().shutdown();
+        Log::Get().shutdown();
 
     }catch(const std::exception& e)
     {
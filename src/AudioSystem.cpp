@@ -0,0 +1,811 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <miniaudio.h>
+
+#include <GLS/Path.hpp>
+
+#include "AudioSystem.hpp"
+#include "CommandQueue.hpp"
+
+
+struct AudioSystem::AudioClip
+{
+    std::string name;
+    std::string path;
+    bool streaming{false};
+
+    // Sólo los clips decodificados tienen PCM residente
+    void* frames{nullptr};
+    ma_uint64 frame_count{0};
+    size_t bytes{0};
+
+    ~AudioClip()
+    {
+        if(frames)
+            ma_free(frames, nullptr);
+    }
+};
+
+struct AudioSystem::VoiceSlot
+{
+    ma_audio_buffer_ref source;
+    ma_sound sound;
+    bool initialized{false};
+
+    // Los clips en streaming tienen su propio ma_sound, vivo mientras suenan
+    ma_sound stream;
+    bool streaming{false};
+
+    ma_sound* current() { return streaming ? &stream : &sound; }
+
+    // Mantiene vivo el PCM mientras la voz lo esté leyendo
+    std::shared_ptr<AudioClip> clip;
+    VoiceParams params;
+    uint32_t generation{0};
+    uint64_t order{0};
+    bool active{false};
+
+    // Últimos valores enviados al hilo de audio
+    glm::vec3 sent_position{0.f, 0.f, 0.f};
+    float sent_volume{1.f};
+
+    // Ticket del último Start: hasta que se aplica, el ma_sound tiene el estado anterior
+    uint64_t start_ticket{0};
+
+    // El stream no se libera hasta que el hilo de audio ha aplicado su Stop
+    bool retiring{false};
+    uint64_t retire_ticket{0};
+
+    // Voz virtual: no se mezcla pero su cursor sigue avanzando
+    bool virtualized{false};
+    double cursor{0.0};
+    ma_uint32 sample_rate{0};
+    ma_uint64 length{0};
+
+    // Dónde se paró al virtualizarse: lo escribe el hilo de audio y se lee cuando
+    // se ha aplicado el ticket. Hasta entonces sólo se cuenta el tiempo.
+    uint64_t virtualize_ticket{0};
+    double elapsed{0.0};
+    ma_uint64 stop_cursor{0};
+    ma_uint64 stop_length{0};
+    ma_uint32 stop_sample_rate{0};
+};
+
+struct AudioSystem::Command
+{
+    enum class Type : uint8_t
+    {
+        SetData,
+        Configure,
+        Seek,
+        Start,
+        Stop,
+        Virtualize,
+        Position,
+        Volume,
+        ListenerPosition,
+        ListenerDirection
+    };
+
+    Type type{Type::Stop};
+    ma_sound* sound{nullptr};
+    VoiceSlot* slot{nullptr};
+    ma_audio_buffer_ref* source{nullptr};
+    const void* data{nullptr};
+    ma_uint64 frames{0};
+    glm::vec3 vec{0.f, 0.f, 0.f};
+    float volume{1.f};
+    float min_distance{1.f};
+    float max_distance{20.f};
+    bool loop{false};
+    bool spatial{true};
+};
+
+struct AudioSystem::CommandBuffer
+{
+    CommandQueue<Command, 1024> queue;
+
+    // Comandos del frame en curso y los que no cupieron en la cola
+    std::vector<Command> staged;
+    uint64_t staged_total{0};
+
+    // PCM que una voz ha dejado de usar: vive hasta que el hilo de audio aplica el ticket
+    struct Retired
+    {
+        std::shared_ptr<AudioClip> clip;
+        uint64_t ticket{0};
+    };
+    std::vector<Retired> retired;
+};
+
+
+AudioSystem::AudioSystem() = default;
+
+AudioSystem::~AudioSystem()
+{
+    shutdown();
+}
+
+AudioSystem& AudioSystem::Get()
+{
+    static AudioSystem instance;
+    return instance;
+}
+
+bool AudioSystem::init(const AudioSettings& settings)
+{
+    if(m_engine)
+        return true;
+
+    m_settings = settings;
+    m_engine = new ma_engine;
+    m_commands = std::make_unique<CommandBuffer>();
+
+    // Los comandos del frame se aplican en el hilo de audio entre una mezcla y la siguiente
+    ma_engine_config config = ma_engine_config_init();
+    if(settings.offline)
+    {
+        config.noDevice = MA_TRUE;
+        config.channels = settings.channels;
+        config.sampleRate = settings.sample_rate;
+    }else
+    {
+        config.pProcessUserData = this;
+        config.onProcess = [](void* user, float*, ma_uint64) {
+            static_cast<AudioSystem*>(user)->drain();
+        };
+    }
+
+    if(ma_engine_init(&config, m_engine) != MA_SUCCESS)
+    {
+        std::cerr << "[AudioSystem] no se pudo iniciar miniaudio" << std::endl;
+        delete m_engine;
+        m_engine = nullptr;
+        m_commands.reset();
+        return false;
+    }
+
+    // Las voces se crean una vez con un frame de silencio y luego sólo se les
+    // cambia el PCM: todos los clips comparten el formato del motor
+    static const float silence[64] = {};
+    ma_uint32 channels = ma_engine_get_channels(m_engine);
+    ma_uint32 sample_rate = ma_engine_get_sample_rate(m_engine);
+
+    m_voice_count = settings.max_voices;
+    m_voices = std::make_unique<VoiceSlot[]>(m_voice_count);
+
+    for(unsigned i = 0; i < m_voice_count; i++)
+    {
+        auto& slot = m_voices[i];
+
+        if(ma_audio_buffer_ref_init(ma_format_f32, channels, silence, 1, &slot.source) != MA_SUCCESS)
+            continue;
+        slot.source.sampleRate = sample_rate;
+
+        if(ma_sound_init_from_data_source(m_engine, &slot.source, 0, nullptr, &slot.sound) != MA_SUCCESS)
+        {
+            ma_audio_buffer_ref_uninit(&slot.source);
+            continue;
+        }
+
+        slot.initialized = true;
+    }
+
+    m_commands->retired.reserve(m_voice_count);
+
+    m_mix_buffer.resize(size_t(MixBlock) * channels);
+    m_mix_pending = 0.0;
+
+    return true;
+}
+
+void AudioSystem::shutdown()
+{
+    if(!m_engine)
+        return;
+
+    // Sin dispositivo no queda ningún hilo de audio leyendo comandos ni voces
+    if(!m_settings.offline)
+        ma_engine_stop(m_engine);
+
+    for(unsigned i = 0; i < m_voice_count; i++)
+    {
+        auto& slot = m_voices[i];
+        if(!slot.initialized)
+            continue;
+
+        if(slot.streaming)
+            ma_sound_uninit(&slot.stream);
+        ma_sound_uninit(&slot.sound);
+        ma_audio_buffer_ref_uninit(&slot.source);
+    }
+
+    m_voices.reset();
+    m_voice_count = 0;
+
+    m_clips.clear();
+    m_paths.clear();
+
+    ma_engine_uninit(m_engine);
+    delete m_engine;
+    m_engine = nullptr;
+    m_commands.reset();
+    m_mix_buffer.clear();
+}
+
+void AudioSystem::update(float dt)
+{
+    if(!m_engine)
+        return;
+
+    reclaim();
+
+    for(unsigned i = 0; i < m_voice_count; i++)
+    {
+        auto& slot = m_voices[i];
+
+        if(slot.retiring)
+        {
+            retire(slot);
+            continue;
+        }
+
+        if(!slot.active || pending(slot))
+            continue;
+
+        if(slot.virtualized)
+        {
+            if(!advance(slot, dt))
+                release(slot);
+            else if(slot.virtualize_ticket == 0 && isAudible(slot))
+                devirtualize(slot);
+            continue;
+        }
+
+        if(!ma_sound_is_playing(slot.current()) && ma_sound_at_end(slot.current()))
+            release(slot);
+        else if(!isAudible(slot))
+            virtualize(slot);
+    }
+
+    flush();
+
+    // Sin dispositivo el bucle de juego hace de hilo de audio
+    if(m_settings.offline)
+    {
+        m_mix_pending += double(dt) * ma_engine_get_sample_rate(m_engine);
+        uint64_t frames = uint64_t(m_mix_pending);
+        m_mix_pending -= double(frames);
+
+        mix(frames);
+    }
+}
+
+AudioSystem::Clip AudioSystem::addAudio(const std::string& filename, bool streaming)
+{
+    if(!m_engine)
+        return InvalidClip;
+
+    auto it = m_paths.find(filename);
+    if(it != m_paths.end() && m_clips[it->second]->streaming == streaming)
+        return it->second;
+
+    auto clip = std::make_shared<AudioClip>();
+    clip->name = filename;
+    clip->path = (AUDIOS_PATH / filename).string();
+    clip->streaming = streaming;
+
+    // En streaming no se decodifica nada aquí, cada reproducción abre el fichero
+    if(!streaming)
+    {
+        ma_uint32 channels = ma_engine_get_channels(m_engine);
+        ma_decoder_config config = ma_decoder_config_init(ma_format_f32, channels, ma_engine_get_sample_rate(m_engine));
+
+        if(ma_decode_file(clip->path.c_str(), &config, &clip->frame_count, &clip->frames) != MA_SUCCESS)
+        {
+            std::cerr << "[AudioSystem] no se pudo decodificar: " << clip->path << std::endl;
+            return InvalidClip;
+        }
+
+        clip->bytes = size_t(clip->frame_count) * channels * sizeof(float);
+    }
+
+    m_clips.push_back(std::move(clip));
+    m_paths[filename] = m_clips.size() - 1;
+
+    return m_clips.size() - 1;
+}
+
+AudioSystem::Clip AudioSystem::addAudio(const std::string& name, const std::vector<float>& frames)
+{
+    if(!m_engine)
+        return InvalidClip;
+
+    ma_uint32 channels = ma_engine_get_channels(m_engine);
+
+    auto clip = std::make_shared<AudioClip>();
+    clip->name = name;
+    clip->bytes = frames.size() * sizeof(float);
+    clip->frame_count = frames.size() / channels;
+    clip->frames = ma_malloc(clip->bytes, nullptr);
+
+    if(!clip->frames)
+        return InvalidClip;
+
+    std::copy(frames.begin(), frames.end(), static_cast<float*>(clip->frames));
+
+    m_clips.push_back(std::move(clip));
+    m_paths[name] = m_clips.size() - 1;
+
+    return m_clips.size() - 1;
+}
+
+void AudioSystem::clearAudio(Clip clip)
+{
+    if(clip >= m_clips.size() || !m_clips[clip])
+        return;
+
+    auto it = m_paths.find(m_clips[clip]->name);
+    if(it != m_paths.end() && it->second == clip)
+        m_paths.erase(it);
+
+    m_clips[clip].reset();
+}
+
+AudioSystem::Voice AudioSystem::play(Clip clip, const VoiceParams& params)
+{
+    if(!m_engine || clip >= m_clips.size() || !m_clips[clip])
+        return {};
+
+    VoiceSlot* slot = acquire(params.priority);
+    if(!slot)
+        return {};
+
+    auto& data = m_clips[clip];
+
+    if(data->streaming)
+    {
+        // El resource manager abre el fichero y decodifica por páginas en su hilo
+        // de trabajo. miniaudio no deja crear ni destruir un ma_sound desde el hilo
+        // de audio, así que se crea aquí; nace parado y no se mezcla hasta el Start.
+        ma_uint32 flags = MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_ASYNC;
+        if(ma_sound_init_from_file(m_engine, data->path.c_str(), flags, nullptr, nullptr, &slot->stream) != MA_SUCCESS)
+        {
+            std::cerr << "[AudioSystem] no se pudo abrir el stream: " << data->path << std::endl;
+            return {};
+        }
+        slot->streaming = true;
+        slot->length = 0;
+    }else
+    {
+        Command set_data;
+        set_data.type = Command::Type::SetData;
+        set_data.source = &slot->source;
+        set_data.data = data->frames;
+        set_data.frames = data->frame_count;
+        send(set_data);
+
+        slot->length = data->frame_count;
+    }
+
+    Command configure;
+    configure.type = Command::Type::Configure;
+    configure.sound = slot->current();
+    configure.loop = params.loop;
+    configure.spatial = params.spatial;
+    configure.min_distance = params.min_distance;
+    configure.max_distance = params.max_distance;
+    configure.vec = params.position;
+    configure.volume = params.volume;
+    send(configure);
+
+    // Una voz robada (o liberada este frame) puede seguir leyendo el clip anterior
+    // hasta que el hilo de audio aplique su Stop y el SetData de arriba
+    if(slot->clip)
+        m_commands->retired.push_back({std::move(slot->clip), m_commands->staged_total});
+    slot->clip = data;
+    slot->params = params;
+    slot->sent_position = params.position;
+    slot->sent_volume = params.volume;
+    slot->order = ++m_play_order;
+    slot->active = true;
+    slot->cursor = 0.0;
+    slot->sample_rate = ma_engine_get_sample_rate(m_engine);
+
+    // Si nace fuera de rango empieza ya como voz virtual
+    if(isAudible(*slot))
+        start(*slot, 0);
+    else
+        slot->virtualized = true;
+
+    return {static_cast<uint32_t>(slot - m_voices.get()), slot->generation};
+}
+
+void AudioSystem::stop(Voice voice)
+{
+    if(auto slot = find(voice))
+        release(*slot);
+}
+
+bool AudioSystem::isPlaying(Voice voice) const
+{
+    auto slot = find(voice);
+    return slot && (slot->virtualized || pending(*slot) || ma_sound_is_playing(slot->current()));
+}
+
+void AudioSystem::setPosition(Voice voice, const glm::vec3& pos)
+{
+    if(auto slot = find(voice))
+        slot->params.position = pos;
+}
+
+void AudioSystem::setVolume(Voice voice, float volume)
+{
+    if(auto slot = find(voice))
+        slot->params.volume = volume;
+}
+
+void AudioSystem::setListenerPosition(const glm::vec3& pos)
+{
+    m_listener = pos;
+}
+
+void AudioSystem::setListenerDirection(const glm::vec3& forward)
+{
+    m_listener_dir = forward;
+}
+
+void AudioSystem::mix(uint64_t frames)
+{
+    if(!m_engine || !m_settings.offline)
+        return;
+
+    drain();
+
+    while(frames > 0)
+    {
+        uint64_t block = std::min<uint64_t>(frames, MixBlock);
+        ma_engine_read_pcm_frames(m_engine, m_mix_buffer.data(), block, nullptr);
+        frames -= block;
+    }
+
+    reclaim();
+}
+
+unsigned AudioSystem::getChannels() const
+{
+    return m_engine ? ma_engine_get_channels(m_engine) : 0;
+}
+
+unsigned AudioSystem::getSampleRate() const
+{
+    return m_engine ? ma_engine_get_sample_rate(m_engine) : 0;
+}
+
+unsigned AudioSystem::getActiveVoices() const
+{
+    unsigned count = 0;
+    for(unsigned i = 0; i < m_voice_count; i++)
+        if(m_voices[i].active)
+            count++;
+
+    return count;
+}
+
+unsigned AudioSystem::getAudibleVoices() const
+{
+    unsigned count = 0;
+    for(unsigned i = 0; i < m_voice_count; i++)
+        if(m_voices[i].active && !m_voices[i].virtualized)
+            count++;
+
+    return count;
+}
+
+bool AudioSystem::hasPendingCommands() const
+{
+    if(!m_commands)
+        return false;
+
+    return !m_commands->staged.empty() || m_commands->queue.consumed() < m_commands->queue.written();
+}
+
+size_t AudioSystem::getResidentBytes() const
+{
+    size_t bytes = 0;
+    for(auto& clip : m_clips)
+        if(clip)
+            bytes += clip->bytes;
+
+    return bytes;
+}
+
+AudioSystem::VoiceSlot* AudioSystem::find(Voice voice) const
+{
+    if(voice.index >= m_voice_count)
+        return nullptr;
+
+    auto& slot = m_voices[voice.index];
+    return slot.active && slot.generation == voice.generation ? &slot : nullptr;
+}
+
+AudioSystem::VoiceSlot* AudioSystem::acquire(int priority)
+{
+    VoiceSlot* victim = nullptr;
+
+    for(unsigned i = 0; i < m_voice_count; i++)
+    {
+        auto& slot = m_voices[i];
+        if(!slot.initialized || slot.retiring)
+            continue;
+
+        if(!slot.active)
+            return &slot;
+
+        if(!victim || steals(slot, *victim))
+            victim = &slot;
+    }
+
+    if(!victim || victim->params.priority > priority)
+        return nullptr;
+
+    // Un stream robado no queda libre hasta que el hilo de audio lo ha parado
+    release(*victim);
+    return victim->retiring ? nullptr : victim;
+}
+
+bool AudioSystem::steals(const VoiceSlot& slot, const VoiceSlot& victim) const
+{
+    // Menor prioridad primero, entre iguales las virtuales y después la más antigua
+    if(slot.params.priority != victim.params.priority)
+        return slot.params.priority < victim.params.priority;
+
+    if(slot.virtualized != victim.virtualized)
+        return slot.virtualized;
+
+    return slot.order < victim.order;
+}
+
+bool AudioSystem::isAudible(const VoiceSlot& slot) const
+{
+    if(!slot.params.spatial)
+        return true;
+
+    float distance = glm::length(slot.params.position - m_listener);
+    if(distance > slot.params.max_distance)
+        return false;
+
+    // Misma curva que la atenuación inversa por defecto de miniaudio
+    float min_distance = std::max(slot.params.min_distance, 0.0001f);
+    float clamped = std::clamp(distance, min_distance, slot.params.max_distance);
+    float gain = min_distance / clamped;
+
+    return slot.params.volume * gain >= m_settings.audibility_threshold;
+}
+
+void AudioSystem::virtualize(VoiceSlot& slot)
+{
+    // El hilo de audio la para y apunta dónde estaba
+    Command cmd;
+    cmd.type = Command::Type::Virtualize;
+    cmd.sound = slot.current();
+    cmd.slot = &slot;
+
+    slot.virtualize_ticket = send(cmd);
+    slot.elapsed = 0.0;
+    slot.virtualized = true;
+}
+
+void AudioSystem::devirtualize(VoiceSlot& slot)
+{
+    start(slot, ma_uint64(slot.cursor));
+    slot.virtualized = false;
+}
+
+bool AudioSystem::advance(VoiceSlot& slot, float dt)
+{
+    if(slot.virtualize_ticket != 0)
+    {
+        slot.elapsed += dt;
+        if(m_commands->queue.consumed() < slot.virtualize_ticket)
+            return true;
+
+        slot.sample_rate = slot.stop_sample_rate;
+        slot.length = slot.stop_length;
+        slot.cursor = double(slot.stop_cursor) + slot.elapsed * slot.sample_rate;
+        slot.virtualize_ticket = 0;
+        dt = 0.f;
+    }
+
+    slot.cursor += double(dt) * slot.sample_rate;
+
+    // Streams asíncronos pueden no conocer aún su duración
+    if(slot.length == 0 || slot.cursor < double(slot.length))
+        return true;
+
+    if(!slot.params.loop)
+        return false;
+
+    slot.cursor = std::fmod(slot.cursor, double(slot.length));
+    return true;
+}
+
+void AudioSystem::start(VoiceSlot& slot, uint64_t frame)
+{
+    Command seek;
+    seek.type = Command::Type::Seek;
+    seek.sound = slot.current();
+    seek.frames = frame;
+    send(seek);
+
+    Command start;
+    start.type = Command::Type::Start;
+    start.sound = slot.current();
+    slot.start_ticket = send(start);
+}
+
+bool AudioSystem::pending(const VoiceSlot& slot) const
+{
+    return m_commands->queue.consumed() < slot.start_ticket;
+}
+
+void AudioSystem::release(VoiceSlot& slot)
+{
+    Command stop;
+    stop.type = Command::Type::Stop;
+    stop.sound = slot.current();
+    uint64_t ticket = send(stop);
+
+    slot.active = false;
+    slot.virtualized = false;
+    slot.start_ticket = 0;
+    slot.virtualize_ticket = 0;
+    slot.generation++;
+
+    if(slot.streaming)
+    {
+        slot.retiring = true;
+        slot.retire_ticket = ticket;
+    }
+}
+
+void AudioSystem::retire(VoiceSlot& slot)
+{
+    if(m_commands->queue.consumed() < slot.retire_ticket)
+        return;
+
+    ma_sound_uninit(&slot.stream);
+    slot.streaming = false;
+    slot.retiring = false;
+}
+
+uint64_t AudioSystem::send(const Command& cmd)
+{
+    m_commands->staged.push_back(cmd);
+
+    // El comando n-ésimo está aplicado cuando consumed() >= n
+    return ++m_commands->staged_total;
+}
+
+void AudioSystem::flush()
+{
+    // Sólo se envían los valores continuos que han cambiado desde el último frame
+    for(unsigned i = 0; i < m_voice_count; i++)
+    {
+        auto& slot = m_voices[i];
+        if(!slot.active || slot.virtualized)
+            continue;
+
+        if(slot.params.position != slot.sent_position)
+        {
+            Command cmd;
+            cmd.type = Command::Type::Position;
+            cmd.sound = slot.current();
+            cmd.vec = slot.params.position;
+            send(cmd);
+            slot.sent_position = slot.params.position;
+        }
+
+        if(slot.params.volume != slot.sent_volume)
+        {
+            Command cmd;
+            cmd.type = Command::Type::Volume;
+            cmd.sound = slot.current();
+            cmd.volume = slot.params.volume;
+            send(cmd);
+            slot.sent_volume = slot.params.volume;
+        }
+    }
+
+    if(m_listener != m_sent_listener)
+    {
+        Command cmd;
+        cmd.type = Command::Type::ListenerPosition;
+        cmd.vec = m_listener;
+        send(cmd);
+        m_sent_listener = m_listener;
+    }
+
+    if(m_listener_dir != m_sent_listener_dir)
+    {
+        Command cmd;
+        cmd.type = Command::Type::ListenerDirection;
+        cmd.vec = m_listener_dir;
+        send(cmd);
+        m_sent_listener_dir = m_listener_dir;
+    }
+
+    // Si la cola está llena lo que sobra espera al siguiente frame, nunca se bloquea
+    auto& commands = *m_commands;
+
+    size_t pushed = 0;
+    while(pushed < commands.staged.size() && commands.queue.push(commands.staged[pushed]))
+        pushed++;
+
+    commands.staged.erase(commands.staged.begin(), commands.staged.begin() + pushed);
+    commands.queue.publish();
+}
+
+void AudioSystem::reclaim()
+{
+    // Sólo el hilo de juego suelta las referencias, nunca el callback de audio
+    uint64_t consumed = m_commands->queue.consumed();
+    auto& retired = m_commands->retired;
+
+    retired.erase(
+        std::remove_if(retired.begin(), retired.end(), [consumed](const auto& entry) { return entry.ticket <= consumed; }),
+        retired.end()
+    );
+}
+
+void AudioSystem::drain()
+{
+    m_commands->queue.drain([this](const Command& cmd) { apply(cmd); });
+}
+
+void AudioSystem::apply(const Command& cmd)
+{
+    switch(cmd.type)
+    {
+        case Command::Type::SetData:
+            ma_audio_buffer_ref_set_data(cmd.source, cmd.data, cmd.frames);
+            break;
+        case Command::Type::Configure:
+            ma_sound_set_looping(cmd.sound, cmd.loop);
+            ma_sound_set_spatialization_enabled(cmd.sound, cmd.spatial);
+            ma_sound_set_min_distance(cmd.sound, cmd.min_distance);
+            ma_sound_set_max_distance(cmd.sound, cmd.max_distance);
+            ma_sound_set_position(cmd.sound, cmd.vec.x, cmd.vec.y, cmd.vec.z);
+            ma_sound_set_volume(cmd.sound, cmd.volume);
+            break;
+        case Command::Type::Seek:
+            ma_sound_seek_to_pcm_frame(cmd.sound, cmd.frames);
+            break;
+        case Command::Type::Start:
+            ma_sound_start(cmd.sound);
+            break;
+        case Command::Type::Stop:
+            ma_sound_stop(cmd.sound);
+            break;
+        case Command::Type::Virtualize:
+            ma_sound_stop(cmd.sound);
+            ma_sound_get_cursor_in_pcm_frames(cmd.sound, &cmd.slot->stop_cursor);
+            ma_sound_get_length_in_pcm_frames(cmd.sound, &cmd.slot->stop_length);
+            ma_sound_get_data_format(cmd.sound, nullptr, nullptr, &cmd.slot->stop_sample_rate, nullptr, 0);
+            break;
+        case Command::Type::Position:
+            ma_sound_set_position(cmd.sound, cmd.vec.x, cmd.vec.y, cmd.vec.z);
+            break;
+        case Command::Type::Volume:
+            ma_sound_set_volume(cmd.sound, cmd.volume);
+            break;
+        case Command::Type::ListenerPosition:
+            ma_engine_listener_set_position(m_engine, 0, cmd.vec.x, cmd.vec.y, cmd.vec.z);
+            break;
+        case Command::Type::ListenerDirection:
+            ma_engine_listener_set_direction(m_engine, 0, cmd.vec.x, cmd.vec.y, cmd.vec.z);
+            break;
+    }
+}
@@ -0,0 +1,65 @@
+#include <iostream>
+
+#include <GLS/Physics.hpp>
+
+#include "BodyIDs.hpp"
+
+
+BodyIDs& BodyIDs::Get()
+{
+    static BodyIDs instance;
+    return instance;
+}
+
+JPH::BodyID BodyIDs::Track(const std::shared_ptr<Engine::Body>& body)
+{
+    if(!body || !body->IsValid())
+        return JPH::BodyID();
+
+    // Los cuerpos nuevos (o con el índice reciclado) desde el último Track()
+    Engine::Physics::Get().GetSystem().GetBodies(m_bodies);
+    m_new.clear();
+
+    for(JPH::BodyID id : m_bodies)
+    {
+        uint32_t index = id.GetIndex();
+        if(index >= m_known.size())
+            m_known.resize(index + 1, Unknown);
+
+        if(m_known[index] != id.GetIndexAndSequenceNumber())
+        {
+            m_known[index] = id.GetIndexAndSequenceNumber();
+            m_new.push_back(id);
+        }
+    }
+
+    JPH::BodyID found = m_new.empty() ? JPH::BodyID() : m_new.back();
+    if(m_new.size() > 1)
+    {
+        auto& bodies = Engine::Physics::Get().GetBodyInterface();
+        JPH::RVec3 pos = body->GetPosition();
+
+        for(JPH::BodyID id : m_new)
+            if(bodies.GetPosition(id).IsClose(pos))
+                found = id;
+    }
+
+    if(found.IsInvalid())
+    {
+        // Ya apuntado en un Track() anterior
+        if(auto it = m_ids.find(body.get()); it != m_ids.end())
+            return it->second;
+
+        std::cerr << "[BodyIDs] No hay ningún cuerpo nuevo en el PhysicsSystem" << std::endl;
+        return found;
+    }
+
+    m_ids[body.get()] = found;
+    return found;
+}
+
+JPH::BodyID BodyIDs::Find(const std::shared_ptr<Engine::Body>& body) const
+{
+    auto it = body ? m_ids.find(body.get()) : m_ids.end();
+    return it == m_ids.end() ? JPH::BodyID() : it->second;
+}
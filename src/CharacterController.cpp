@@ -0,0 +1,273 @@
+#include <GLS/Physics.hpp>
+#include <GLS/Body.hpp>
+#include <GLS/Utils.hpp>
+
+#include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
+#include <Jolt/Physics/Collision/ShapeFilter.h>
+
+#include "BodyIDs.hpp"
+#include "CharacterController.hpp"
+#include "Coroutine.hpp"
+#include "Triggers.hpp"
+
+
+CharacterController::CharacterController(const glm::vec3& pos, const CharacterSettings& settings)
+    : m_settings(settings), m_allocator(256 * 1024)
+{
+    m_layer = CollisionLayers::Get().Register(settings.layer);
+
+    JPH::CharacterVirtualSettings s;
+    s.mShape = new JPH::CapsuleShape(settings.half_height, settings.radius);
+    s.mMaxSlopeAngle = JPH::DegreesToRadians(settings.max_slope_angle);
+    s.mSupportingVolume = JPH::Plane(JPH::Vec3::sAxisY(), -settings.radius);
+
+    m_character = new JPH::CharacterVirtual(
+        &s,
+        JPH::RVec3(pos.x, pos.y, pos.z),
+        JPH::Quat::sIdentity(),
+        &Engine::Physics::Get().GetSystem()
+    );
+    m_character->SetListener(this);
+
+    m_update_settings.mWalkStairsStepUp = {0.f, settings.step_up, 0.f};
+    m_update_settings.mStickToFloorStepDown = {0.f, -settings.stick_to_floor, 0.f};
+}
+
+CharacterController::~CharacterController()
+{
+    m_character->SetListener(nullptr);
+}
+
+void CharacterController::setMoveDirection(const glm::vec3& dir) noexcept
+{
+    m_move_dir = {dir.x, 0.f, dir.z};
+}
+
+void CharacterController::jump() noexcept
+{
+    m_jump_requested = true;
+}
+
+void CharacterController::setOnStep(StepCallback callback) noexcept
+{
+    m_on_step = std::move(callback);
+}
+
+void CharacterController::setPosition(const glm::vec3& pos)
+{
+    m_character->SetPosition(JPH::RVec3(pos.x, pos.y, pos.z));
+
+    if(body)
+        body->SetPosition(pos);
+}
+
+void CharacterController::setLinearVelocity(const glm::vec3& velocity)
+{
+    m_character->SetLinearVelocity(Engine::Utils::toJoltVec3(velocity));
+}
+
+glm::vec3 CharacterController::getPosition() const
+{
+    return Engine::Utils::toGLMVec3(JPH::Vec3(m_character->GetPosition()));
+}
+
+glm::vec3 CharacterController::getLinearVelocity() const
+{
+    return Engine::Utils::toGLMVec3(m_character->GetLinearVelocity());
+}
+
+JPH::CharacterBase::EGroundState CharacterController::getGroundState() const
+{
+    return m_character->GetGroundState();
+}
+
+bool CharacterController::isGrounded() const
+{
+    return m_character->GetGroundState() == JPH::CharacterBase::EGroundState::OnGround;
+}
+
+bool CharacterController::isOnSteepGround() const
+{
+    return m_character->GetGroundState() == JPH::CharacterBase::EGroundState::OnSteepGround;
+}
+
+bool CharacterController::isSlopeTooSteep(const glm::vec3& normal) const
+{
+    return m_character->IsSlopeTooSteep(Engine::Utils::toJoltVec3(normal));
+}
+
+glm::vec3 CharacterController::getGroundNormal() const
+{
+    return Engine::Utils::toGLMVec3(m_character->GetGroundNormal());
+}
+
+glm::vec3 CharacterController::getGroundVelocity() const
+{
+    return Engine::Utils::toGLMVec3(m_character->GetGroundVelocity());
+}
+
+JPH::BodyID CharacterController::getGroundBodyID() const
+{
+    return m_character->GetGroundBodyID();
+}
+
+void CharacterController::Add(Event event, JPH::BodyID id, Callback callback)
+{
+    Key key = id.GetIndexAndSequenceNumber();
+
+    if(event == Event::ContactAdded)
+        m_callbacks_added[key].push_back(callback);
+    else
+        m_callbacks_removed[key].push_back(callback);
+}
+
+void CharacterController::Add(Event event, const std::shared_ptr<Engine::GameObject>& object, Callback callback)
+{
+    if(object && object->getBody())
+        Add(event, BodyIDs::Get().Find(object->getBody()), callback);
+}
+
+void CharacterController::SaveState(JPH::StateRecorder& stream) const
+{
+    m_character->SaveState(stream);
+    stream.Write(m_move_dir);
+    stream.Write(m_jump_requested);
+    stream.Write(m_accumulator);
+}
+
+void CharacterController::RestoreState(JPH::StateRecorder& stream)
+{
+    m_character->RestoreState(stream);
+    stream.Read(m_move_dir);
+    stream.Read(m_jump_requested);
+    stream.Read(m_accumulator);
+    m_pending.clear();
+
+    if(body)
+        body->SetPosition(getPosition(), JPH::EActivation::DontActivate);
+}
+
+void CharacterController::OnPhysicsUpdate(float dt)
+{
+    // Paso fijo: el movimiento no depende de la tasa de frames
+    m_accumulator += dt;
+
+    unsigned steps = 0;
+    while(m_accumulator >= m_settings.fixed_step && steps < m_settings.max_sub_steps)
+    {
+        if(m_on_step)
+            m_on_step(m_settings.fixed_step);
+
+        step(m_settings.fixed_step);
+        m_accumulator -= m_settings.fixed_step;
+        ++steps;
+    }
+
+    if(steps == m_settings.max_sub_steps)
+        m_accumulator = 0.f;
+
+    if(steps > 0 && body)
+        body->SetPosition(getPosition(), JPH::EActivation::DontActivate);
+
+    dispatch();
+}
+
+void CharacterController::step(float dt)
+{
+    auto& system = Engine::Physics::Get().GetSystem();
+    JPH::Vec3 up = m_character->GetUp();
+    JPH::Vec3 gravity = system.GetGravity();
+
+    m_character->UpdateGroundVelocity();
+
+    JPH::Vec3 current_vertical = m_character->GetLinearVelocity().Dot(up) * up;
+    JPH::Vec3 ground_velocity = m_character->GetGroundVelocity();
+    bool moving_towards_ground = (current_vertical.GetY() - ground_velocity.GetY()) < 0.1f;
+
+    JPH::Vec3 velocity;
+    if(isGrounded() && moving_towards_ground)
+    {
+        velocity = ground_velocity;
+        if(m_jump_requested)
+            velocity += m_settings.jump_speed * up;
+    }else
+        velocity = current_vertical;
+
+    m_jump_requested = false;
+
+    velocity += gravity * dt;
+    velocity += Engine::Utils::toJoltVec3(m_move_dir) * m_settings.move_speed;
+
+    m_character->SetLinearVelocity(velocity);
+
+    // El cuerpo cinemático que sigue al personaje no debe bloquearlo
+    auto& layers = CollisionLayers::Get();
+    auto broadphase_filter = layers.MakeBroadPhaseFilter(m_layer);
+    auto layer_filter = layers.MakeObjectLayerFilter(m_layer);
+    auto body_filter = layers.MakeBodyFilter(m_layer, body ? BodyIDs::Get().Find(body) : JPH::BodyID());
+
+    m_character->ExtendedUpdate(
+        dt,
+        gravity,
+        m_update_settings,
+        broadphase_filter,
+        layer_filter,
+        body_filter,
+        JPH::ShapeFilter(),
+        m_allocator
+    );
+}
+
+void CharacterController::OnContactAdded(
+    const JPH::CharacterVirtual *,
+    const JPH::BodyID &inBodyID2,
+    const JPH::SubShapeID &,
+    JPH::RVec3Arg,
+    JPH::Vec3Arg,
+    JPH::CharacterContactSettings &)
+{
+    // El personaje es virtual: sus contactos no pasan por el ContactListener del sistema
+    CoroutineScheduler::Get().notifyContact(inBodyID2);
+
+    Callback trigger;
+    if(Triggers::Get().Enter(inBodyID2, trigger))
+    {
+        if(trigger)
+            m_pending.push_back(trigger);
+        return;
+    }
+
+    auto it = m_callbacks_added.find(inBodyID2.GetIndexAndSequenceNumber());
+    if(it != m_callbacks_added.end())
+        m_pending.insert(m_pending.end(), it->second.begin(), it->second.end());
+}
+
+void CharacterController::OnContactRemoved(
+    const JPH::CharacterVirtual *,
+    const JPH::BodyID &inBodyID2,
+    const JPH::SubShapeID &)
+{
+    Callback trigger;
+    if(Triggers::Get().Exit(inBodyID2, trigger))
+    {
+        if(trigger)
+            m_pending.push_back(trigger);
+        return;
+    }
+
+    auto it = m_callbacks_removed.find(inBodyID2.GetIndexAndSequenceNumber());
+    if(it != m_callbacks_removed.end())
+        m_pending.insert(m_pending.end(), it->second.begin(), it->second.end());
+}
+
+void CharacterController::dispatch()
+{
+    if(m_pending.empty())
+        return;
+
+    auto pending = std::move(m_pending);
+    m_pending.clear();
+
+    for(auto& callback : pending)
+        callback();
+}
@@ -0,0 +1,221 @@
+#include <iostream>
+
+#include <GLS/Physics.hpp>
+
+#include "BodyIDs.hpp"
+#include "CollisionLayers.hpp"
+
+
+CollisionLayers::CollisionLayers()
+    : m_broadphase_layers(*this), m_broadphase_filter(*this), m_pair_filter(*this)
+{
+    m_matrix.fill(~uint32_t(0));
+    m_broadphase.fill(BroadPhase::Moving);
+}
+
+CollisionLayers& CollisionLayers::Get()
+{
+    static CollisionLayers instance;
+    return instance;
+}
+
+CollisionLayers::Layer CollisionLayers::Register(const std::string& tag)
+{
+    auto it = m_tags.find(tag);
+    if(it != m_tags.end())
+        return it->second;
+
+    if(m_count == MaxLayers)
+    {
+        std::cerr << "[CollisionLayers] sin capas libres para el tag: " << tag << std::endl;
+        return Invalid;
+    }
+
+    m_tags.insert({tag, m_count});
+    return m_count++;
+}
+
+CollisionLayers::Layer CollisionLayers::Find(const std::string& tag) const
+{
+    auto it = m_tags.find(tag);
+    return it == m_tags.end() ? Invalid : it->second;
+}
+
+void CollisionLayers::SetCollision(const std::string& tag1, const std::string& tag2, bool collide)
+{
+    SetCollision(Register(tag1), Register(tag2), collide);
+}
+
+void CollisionLayers::SetCollision(Layer layer1, Layer layer2, bool collide)
+{
+    if(layer1 >= MaxLayers || layer2 >= MaxLayers)
+        return;
+
+    if(collide)
+    {
+        m_matrix[layer1] |= (1u << layer2);
+        m_matrix[layer2] |= (1u << layer1);
+    }else
+    {
+        m_matrix[layer1] &= ~(1u << layer2);
+        m_matrix[layer2] &= ~(1u << layer1);
+    }
+}
+
+void CollisionLayers::SetBroadPhase(const std::string& tag, BroadPhase broadphase)
+{
+    Layer layer = Register(tag);
+    if(layer == Invalid)
+        return;
+
+    if(broadphase != BroadPhase::Moving && broadphase != BroadPhase::Scenery)
+    {
+        std::cerr << "[CollisionLayers] un tag sólo puede ir a Moving o Scenery: " << tag << std::endl;
+        return;
+    }
+
+    m_broadphase[layer] = broadphase;
+    if(broadphase == BroadPhase::Scenery)
+        m_scenery |= (1u << layer);
+    else
+        m_scenery &= ~(1u << layer);
+}
+
+bool CollisionLayers::ShouldCollide(Layer layer1, Layer layer2) const
+{
+    if(layer1 == Parked || layer2 == Parked)
+        return false;
+
+    if(layer1 >= MaxLayers || layer2 >= MaxLayers)
+        return true;
+
+    return (m_matrix[layer1] & (1u << layer2)) != 0;
+}
+
+void CollisionLayers::Assign(const std::shared_ptr<Engine::Body>& body, const std::string& tag)
+{
+    if(!body || !body->IsValid())
+        return;
+
+    Layer layer = Register(tag);
+    if(layer == Invalid)
+        return;
+
+    Assign(body, layer);
+}
+
+void CollisionLayers::Assign(const std::shared_ptr<Engine::Body>& body, Layer layer)
+{
+    if(!body || !body->IsValid())
+        return;
+
+    // Las capas del motor no conocen las de los tags
+    if(!IsInstalled())
+    {
+        if(!m_warned)
+            std::cerr << "[CollisionLayers] PhysicsSetup no ha instalado las capas, los tags no filtran" << std::endl;
+        m_warned = true;
+        return;
+    }
+
+    JPH::ObjectLayer object_layer = ToObjectLayer(layer);
+    if(layer == Invalid && body->getType() == Engine::BodyType::Static)
+        object_layer = EngineStatic;
+
+    Engine::Physics::Get().GetBodyInterface().SetObjectLayer(BodyIDs::Get().Find(body), object_layer);
+}
+
+CollisionLayers::BodyFilter CollisionLayers::MakeBodyFilter(Layer layer, JPH::BodyID ignore) const
+{
+    return BodyFilter(*this, layer, ignore);
+}
+
+JPH::DefaultBroadPhaseLayerFilter CollisionLayers::MakeBroadPhaseFilter(Layer layer) const
+{
+    return JPH::DefaultBroadPhaseLayerFilter(m_broadphase_filter, ToObjectLayer(layer));
+}
+
+JPH::DefaultObjectLayerFilter CollisionLayers::MakeObjectLayerFilter(Layer layer) const
+{
+    return JPH::DefaultObjectLayerFilter(m_pair_filter, ToObjectLayer(layer));
+}
+
+bool CollisionLayers::IsInstalled() const
+{
+    return Engine::Physics::IsInitialized() && &Engine::Physics::Get().GetSystem().GetObjectLayerPairFilter() == &m_pair_filter;
+}
+
+JPH::BroadPhaseLayer CollisionLayers::BroadPhaseLayers::GetBroadPhaseLayer(JPH::ObjectLayer inLayer) const
+{
+    if(inLayer == EngineStatic)
+        return JPH::BroadPhaseLayer(uint8_t(BroadPhase::Static));
+
+    Layer layer = FromObjectLayer(inLayer);
+    if(layer == Parked)
+        return JPH::BroadPhaseLayer(uint8_t(BroadPhase::Parked));
+
+    if(layer >= MaxLayers)
+        return JPH::BroadPhaseLayer(uint8_t(BroadPhase::Moving));
+
+    return JPH::BroadPhaseLayer(uint8_t(m_layers.m_broadphase[layer]));
+}
+
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+const char* CollisionLayers::BroadPhaseLayers::GetBroadPhaseLayerName(JPH::BroadPhaseLayer inLayer) const
+{
+    switch(BroadPhase(inLayer.GetValue()))
+    {
+        case BroadPhase::Static: return "STATIC";
+        case BroadPhase::Moving: return "MOVING";
+        case BroadPhase::Scenery: return "SCENERY";
+        case BroadPhase::Parked: return "PARKED";
+        default: return "INVALID";
+    }
+}
+#endif
+
+bool CollisionLayers::BroadPhaseFilter::ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const
+{
+    Layer layer = FromObjectLayer(inLayer1);
+    BroadPhase broadphase = BroadPhase(inLayer2.GetValue());
+
+    if(layer == Parked || broadphase == BroadPhase::Parked)
+        return false;
+
+    // En Scenery sólo hay tags: basta con que uno de ellos colisione con la capa
+    if(broadphase == BroadPhase::Scenery && layer < MaxLayers)
+        return (m_layers.m_matrix[layer] & m_layers.m_scenery) != 0;
+
+    return true;
+}
+
+bool CollisionLayers::PairFilter::ShouldCollide(JPH::ObjectLayer inLayer1, JPH::ObjectLayer inLayer2) const
+{
+    Layer layer1 = FromObjectLayer(inLayer1);
+    Layer layer2 = FromObjectLayer(inLayer2);
+
+    if(layer1 == Parked || layer2 == Parked)
+        return false;
+
+    // Entre cuerpos sin tag, la regla del motor: los estáticos no chocan entre sí
+    if(layer1 == Invalid && layer2 == Invalid)
+        return inLayer1 != EngineStatic || inLayer2 != EngineStatic;
+
+    return m_layers.ShouldCollide(layer1, layer2);
+}
+
+CollisionLayers::BodyFilter::BodyFilter(const CollisionLayers& layers, Layer layer, JPH::BodyID ignore)
+    : m_layers(layers), m_layer(layer), m_ignore(ignore)
+{
+
+}
+
+bool CollisionLayers::BodyFilter::ShouldCollide(const JPH::BodyID& inBodyID) const
+{
+    return inBodyID != m_ignore;
+}
+
+bool CollisionLayers::BodyFilter::ShouldCollideLocked(const JPH::Body& inBody) const
+{
+    return m_layers.ShouldCollide(m_layer, FromObjectLayer(inBody.GetObjectLayer()));
+}
@@ -0,0 +1,357 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <GLS/Physics.hpp>
+
+#include "BodyIDs.hpp"
+#include "Coroutine.hpp"
+
+
+// --- CoroutineScheduler ---
+
+CoroutineScheduler& CoroutineScheduler::Get()
+{
+    static CoroutineScheduler instance;
+    return instance;
+}
+
+void CoroutineScheduler::attachContacts()
+{
+    if(m_attached || !Engine::Physics::IsInitialized())
+        return;
+
+    auto& system = Engine::Physics::Get().GetSystem();
+    m_next = system.GetContactListener();
+    system.SetContactListener(this);
+    m_attached = true;
+}
+
+void CoroutineScheduler::advance(float dt)
+{
+    m_accumulator += dt;
+    while(m_accumulator >= TickLength)
+    {
+        m_accumulator -= TickLength;
+        ++m_tick;
+
+        fireTimers();
+        resumeReady();
+    }
+
+    fireContacts();
+    resumeReady();
+}
+
+void CoroutineScheduler::sleep(CoroutineWait& wait, float seconds)
+{
+    schedule(wait, seconds);
+}
+
+void CoroutineScheduler::waitContact(CoroutineWait& wait)
+{
+    m_contact_waits[wait.body.GetIndexAndSequenceNumber()].push_back(&wait);
+    m_contact_waiters.fetch_add(1, std::memory_order_relaxed);
+    ++m_pending;
+}
+
+void CoroutineScheduler::cancel(CoroutineWait& wait)
+{
+    auto erase = [&wait](std::vector<CoroutineWait*>& waits) {
+        auto it = std::find(waits.begin(), waits.end(), &wait);
+        if(it == waits.end())
+            return false;
+        waits.erase(it);
+        return true;
+    };
+
+    if(wait.timer)
+    {
+        if(erase(m_wheel[wait.tick & (WheelSize - 1)]))
+            --m_pending;
+        wait.timer = false;
+    }
+    else if(!wait.body.IsInvalid())
+    {
+        auto it = m_contact_waits.find(wait.body.GetIndexAndSequenceNumber());
+        if(it != m_contact_waits.end() && erase(it->second))
+        {
+            m_contact_waiters.fetch_sub(1, std::memory_order_relaxed);
+            --m_pending;
+        }
+    }
+
+    erase(m_ready);
+}
+
+void CoroutineScheduler::notifyContact(JPH::BodyID body)
+{
+    if(m_contact_waiters.load(std::memory_order_relaxed) == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_contacts_mutex);
+    m_contacts.push_back(body.GetIndexAndSequenceNumber());
+}
+
+void CoroutineScheduler::schedule(CoroutineWait& wait, float seconds)
+{
+    uint64_t ticks = std::max<uint64_t>(1, uint64_t(std::ceil(seconds / TickLength)));
+
+    wait.tick = m_tick + ticks;
+    wait.timer = true;
+    m_wheel[wait.tick & (WheelSize - 1)].push_back(&wait);
+    ++m_pending;
+}
+
+void CoroutineScheduler::fireTimers()
+{
+    auto& slot = m_wheel[m_tick & (WheelSize - 1)];
+    if(slot.empty())
+        return;
+
+    // Las esperas de más de una vuelta siguen en el hueco hasta su tick
+    std::vector<CoroutineWait*> due;
+    auto split = std::partition(slot.begin(), slot.end(), [this](CoroutineWait* wait) { return wait->tick > m_tick; });
+    due.assign(split, slot.end());
+    slot.erase(split, slot.end());
+
+    for(CoroutineWait* wait : due)
+    {
+        wait->timer = false;
+        --m_pending;
+
+        float remaining = wait->remaining();
+        if(remaining > 0.f)
+            schedule(*wait, remaining);
+        else
+            m_ready.push_back(wait);
+    }
+}
+
+void CoroutineScheduler::fireContacts()
+{
+    std::vector<uint32_t> contacts;
+    {
+        std::lock_guard<std::mutex> lock(m_contacts_mutex);
+        contacts.swap(m_contacts);
+    }
+
+    for(uint32_t id : contacts)
+    {
+        auto it = m_contact_waits.find(id);
+        if(it == m_contact_waits.end())
+            continue;
+
+        m_contact_waiters.fetch_sub(it->second.size(), std::memory_order_relaxed);
+        m_pending -= it->second.size();
+        m_ready.insert(m_ready.end(), it->second.begin(), it->second.end());
+        m_contact_waits.erase(it);
+    }
+}
+
+void CoroutineScheduler::resumeReady()
+{
+    // Se reanuda en orden de llegada; una corrutina puede cancelar otras de la lista
+    std::reverse(m_ready.begin(), m_ready.end());
+    while(!m_ready.empty())
+    {
+        CoroutineWait* wait = m_ready.back();
+        m_ready.pop_back();
+        wait->handle.resume();
+    }
+}
+
+JPH::ValidateResult CoroutineScheduler::OnContactValidate(
+    const JPH::Body& inBody1,
+    const JPH::Body& inBody2,
+    JPH::RVec3Arg inBaseOffset,
+    const JPH::CollideShapeResult& inCollisionResult)
+{
+    if(m_next)
+        return m_next->OnContactValidate(inBody1, inBody2, inBaseOffset, inCollisionResult);
+
+    return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
+}
+
+void CoroutineScheduler::OnContactAdded(
+    const JPH::Body& inBody1,
+    const JPH::Body& inBody2,
+    const JPH::ContactManifold& inManifold,
+    JPH::ContactSettings& ioSettings)
+{
+    notifyContact(inBody1.GetID());
+    notifyContact(inBody2.GetID());
+
+    if(m_next)
+        m_next->OnContactAdded(inBody1, inBody2, inManifold, ioSettings);
+}
+
+void CoroutineScheduler::OnContactPersisted(
+    const JPH::Body& inBody1,
+    const JPH::Body& inBody2,
+    const JPH::ContactManifold& inManifold,
+    JPH::ContactSettings& ioSettings)
+{
+    if(m_next)
+        m_next->OnContactPersisted(inBody1, inBody2, inManifold, ioSettings);
+}
+
+void CoroutineScheduler::OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair)
+{
+    if(m_next)
+        m_next->OnContactRemoved(inSubShapePair);
+}
+
+
+// --- Behaviour ---
+
+void Behaviour::promise_type::unhandled_exception()
+{
+    try {
+        throw;
+    }catch(const std::exception& e)
+    {
+        std::cerr << "[Behaviour] Excepción en corrutina: " << e.what() << std::endl;
+    }catch(...)
+    {
+        std::cerr << "[Behaviour] Excepción desconocida en corrutina" << std::endl;
+    }
+}
+
+Behaviour& Behaviour::operator=(Behaviour&& other) noexcept
+{
+    if(this != &other)
+    {
+        reset();
+        m_handle = other.m_handle;
+        other.m_handle = {};
+    }
+    return *this;
+}
+
+void Behaviour::start()
+{
+    if(m_handle && !m_handle.done())
+        m_handle.resume();
+}
+
+void Behaviour::reset()
+{
+    if(!m_handle)
+        return;
+
+    if(CoroutineWait* wait = m_handle.promise().waiting)
+        CoroutineScheduler::Get().cancel(*wait);
+
+    m_handle.destroy();
+    m_handle = {};
+}
+
+
+// --- Awaitables ---
+
+void wait_seconds::await_suspend(Behaviour::Handle handle)
+{
+    bind(handle);
+    CoroutineScheduler::Get().sleep(*this, seconds);
+}
+
+namespace
+{
+    float coordinate(const JPH::Vec3& v, Axis axis)
+    {
+        switch(axis)
+        {
+            case Axis::X: return v.GetX();
+            case Axis::Y: return v.GetY();
+            default: return v.GetZ();
+        }
+    }
+}
+
+bool wait_until_position::await_ready()
+{
+    if(!target_body)
+        return true;
+
+    float diff = target - coordinate(JPH::Vec3(target_body->GetPosition()), axis);
+    side = diff >= 0.f ? 1.f : -1.f;
+    return diff * side <= Epsilon;
+}
+
+void wait_until_position::await_suspend(Behaviour::Handle handle)
+{
+    bind(handle);
+    CoroutineScheduler::Get().sleep(*this, remaining());
+}
+
+float wait_until_position::remaining() const
+{
+    float distance = (target - coordinate(JPH::Vec3(target_body->GetPosition()), axis)) * side;
+    if(distance <= Epsilon)
+        return 0.f;
+
+    // Llegada estimada con la velocidad actual; parado o alejándose se revisa más tarde
+    JPH::Vec3 velocity = Engine::Physics::Get().GetBodyInterface().GetLinearVelocity(BodyIDs::Get().Find(target_body));
+    float speed = coordinate(velocity, axis) * side;
+    if(speed <= 0.f)
+        return MaxRecheck;
+
+    return distance / speed;
+}
+
+void wait_for_contact::await_suspend(Behaviour::Handle handle)
+{
+    bind(handle);
+    CoroutineScheduler::Get().waitContact(*this);
+}
+
+
+// --- Scripts ---
+
+void CoroutineScript::OnStart()
+{
+    begin();
+}
+
+void CoroutineScript::OnPhysicsUpdate(float)
+{
+    // Por si el cuerpo se asigna después de OnStart; luego no hace nada
+    if(!m_started)
+        begin();
+}
+
+void CoroutineScript::OnStreamIn()
+{
+    m_streamed_out = false;
+    begin();
+}
+
+void CoroutineScript::OnStreamOut()
+{
+    m_behaviour.reset();
+    m_started = false;
+    m_streamed_out = true;
+}
+
+void CoroutineScript::RestoreState(JPH::StateRecorder&)
+{
+    m_behaviour.reset();
+    m_started = false;
+    begin();
+}
+
+void CoroutineScript::begin()
+{
+    if(m_started || m_streamed_out || !body)
+        return;
+
+    m_started = true;
+    m_behaviour = run();
+    m_behaviour.start();
+}
+
+void CoroutineClock::OnPhysicsUpdate(float dt)
+{
+    CoroutineScheduler::Get().advance(dt);
+}
@@ -0,0 +1,60 @@
+#include <GLFW/glfw3.h>
+
+#include "FramePacer.hpp"
+
+
+FramePacer::FramePacer(const FramePacerSettings& settings)
+    : m_settings(settings)
+{
+}
+
+void FramePacer::idle()
+{
+    double now = glfwGetTime();
+    if(m_last_frame == 0.0)
+        m_last_frame = m_last_event = now;
+
+    if(m_redraw && m_redraw())
+        m_last_event = now;
+
+    bool active = now - m_last_event < m_settings.active_time;
+    float fps = active ? m_settings.max_fps : m_settings.idle_fps;
+    if(fps <= 0.f)
+    {
+        glfwPollEvents();
+        m_last_frame = now;
+        return;
+    }
+
+    // Dormir dentro de GLFW hasta el siguiente frame; si vuelve antes es que llegó un evento
+    double next = m_last_frame + 1.0 / fps;
+    while(now < next)
+    {
+        glfwWaitEventsTimeout(next - now);
+        now = glfwGetTime();
+
+        if(now < next)
+        {
+            m_last_event = now;
+
+            // En reposo un evento adelanta el frame, pero nunca por encima de max_fps
+            if(!active)
+            {
+                active = true;
+                next = m_settings.max_fps > 0.f ? m_last_frame + 1.0 / m_settings.max_fps : now;
+            }
+        }
+    }
+
+    m_last_frame = now;
+}
+
+void FramePacer::setRedrawCheck(RedrawCheck check)
+{
+    m_redraw = std::move(check);
+}
+
+void FramePacer::reset()
+{
+    m_last_frame = m_last_event = 0.0;
+}
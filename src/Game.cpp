@@ -3,13 +3,26 @@
 #include <GLS/SkyBox.hpp>
 #include <GLS/Path.hpp>
 #include <GLS/UIManager.hpp>
-#include <GLS/AudioManager.hpp>
 #include <iostream>
 
 #include "Scripts.hpp"
 #include "Game.hpp"
 #include "inputManager.hpp"
 #include "Level.hpp"
+#include "LevelCompiler.hpp"
+#include "LevelStreamer.hpp"
+#include "ObjectPool.hpp"
+#include "ProjectileSystem.hpp"
+#include "CharacterController.hpp"
+#include "BodyIDs.hpp"
+#include "CollisionLayers.hpp"
+#include "PhysicsMonitor.hpp"
+#include "LatencyMonitor.hpp"
+#include "UIDataModel.hpp"
+#include "UILayer.hpp"
+#include "FramePacer.hpp"
+#include "InputQueue.hpp"
+#include "Triggers.hpp"
 
 Game::Game(std::shared_ptr<Engine::Window> window)
     : m_window(window)
@@ -26,6 +39,7 @@ Game::~Game()
 
 void Game::init()
 {
+    initLayers();
     initScene();
     initSkyBox();
     initUser();
@@ -35,6 +49,9 @@ void Game::init()
     initCollitions();
     initUI();
 
+    // Después del motor y de RmlUi, para encadenar sus callbacks de GLFW
+    InputQueue::Get().attach(m_window->getGLFWWindow());
+
     handleGameOver();
 }
 
@@ -46,9 +63,39 @@ void Game::initScene()
     m_user = m_scene->at(m_user_index);
 }
 
+void Game::initLayers()
+{
+    auto& layers = CollisionLayers::Get();
+
+    // Sólo el jugador interactúa con el escenario. Como sus capas no colisionan
+    // entre sí van al árbol Scenery: las plataformas y enemigos cinemáticos que
+    // se mueven no lo recorren en la broadphase.
+    const std::vector<std::string> world = {"ground", "plataforma", "deco", "enemey", "parachute", "goal", "checkpoint"};
+
+    for (const auto& tag1 : world)
+    {
+        layers.SetBroadPhase(tag1, CollisionLayers::BroadPhase::Scenery);
+        for (const auto& tag2 : world)
+            layers.SetCollision(tag1, tag2, false);
+    }
+
+    layers.Register("player");
+
+    // Las balas no son cuerpos: la capa sólo filtra sus rayos
+    layers.Register("bullet");
+}
+
 void Game::initInput()
 {
     m_input->init(m_scene, m_user);
+    m_input->setCharacter(m_character);
+    m_input->setOnFire([this]() { fire(); });
+    // En pausa sólo se adelanta un frame si hay input o la UI visible ha cambiado
+    auto pacer = std::make_shared<FramePacer>();
+    pacer->setRedrawCheck([this]() { return m_ui_layer && m_ui_layer->consumeChanges(); });
+    m_input->setFramePacer(pacer);
+    if(m_character)
+        m_character->setOnStep([input = m_input.get()](float dt) { input->step(dt); });
     m_window->setInput(m_input);
 }
 
@@ -63,18 +110,46 @@ void Game::initUser()
     m_camera->init(glm::vec3(0.f, 1.5f, -2.5f), m_window->get_aspect_ratio(), 45.f, 0.1f, 100.f, true);
     
     m_camera->activate();
-    m_user->getTransform()->translate(-2.f, 0.f, 0.f);
+    m_user->getTransform()->translate(m_spawn);
 
     //m_user->getTransform()->translate({-3.f, 5.f, 50.f});
     m_user->getTransform()->scale(0.8f, 0.8f, 0.8f);
-    m_scene->createAudioListener(m_user_index);
+    m_user->addScript(std::make_shared<AudioListener>(m_camera));
+    m_user->addScript(std::make_shared<UpdateLODClock>(m_camera));
+
+    // Reloj de las corrutinas de los scripts (plataformas, enemigos...)
+    CoroutineScheduler::Get().attachContacts();
+    m_user->addScript(std::make_shared<CoroutineClock>());
+
+    // Solapamientos de los sensores con cuerpos que no son el personaje
+    Triggers::Get().attachContacts();
+    m_user->addScript(std::make_shared<TriggerClock>());
+
+    m_projectiles = std::make_shared<ProjectileSystem>();
+    m_user->addScript(std::make_shared<ProjectileClock>(m_projectiles));
+
+    // Las balas se ven como un bloque pequeño sin cuerpo; el pool se crea entero aquí
+    ObstacleSettings bullet_settings;
+    bullet_settings.scale = {0.05f, 0.1f, 0.05f};
+    auto bullet = PrefabLibrary::Get().add(std::make_shared<const Prefab>("bullet", "ground/base.fbx", "bullet", bullet_settings));
+
+    PoolSettings bullet_pool;
+    bullet_pool.prewarm = bullet_pool.max = VisibleBullets;
+    m_user->addScript(std::make_shared<ProjectileView>(m_projectiles, std::make_shared<ObjectPool>(m_scene, bullet, bullet_pool)));
 
     auto pj_model = m_scene->createModel(m_user_index);
     pj_model->loadModel("girl.fbx");
     pj_model->setRelativeModel(glm::vec3(0.f, -0.72f, 0.f));
 
-    m_user->setBody(Engine::Physics::Get().CreateBox({0.25f, 0.6f, 0.25f}, {0.f, 0.0f, 0.f}, Engine::BodyType::Dynamic));
-    
+    // El cuerpo cinemático sólo sigue al controlador del personaje
+    m_user->setBody(Engine::Physics::Get().CreateBox({0.25f, 0.6f, 0.25f}, {-2.f, 0.0f, 0.f}, Engine::BodyType::Kinematic));
+    BodyIDs::Get().Track(m_user->getBody());
+
+    CollisionLayers::Get().Assign(m_user->getBody(), "player");
+
+    m_character = std::make_shared<CharacterController>(glm::vec3(-2.f, 0.f, 0.f));
+    m_user->addScript(m_character);
+
 }
 
 void Game::initGround()
@@ -84,6 +159,7 @@ void Game::initGround()
     m_scene->at(ground)->getTransform()->translate(0.f, -0.5f, 0.f);
     m_scene->at(ground)->getTransform()->scale(5.f, 1.f, 5.f);
     m_scene->at(ground)->setBody(Engine::Physics::Get().CreateBox({5.f, 0.5f, 5.f}, {0.f, 0.f, 0.f}, Engine::BodyType::Static));
+    BodyIDs::Get().Track(m_scene->at(ground)->getBody());
 }
 
 void Game::initRenderer()
@@ -96,7 +172,22 @@ void Game::initRenderer()
 
 void Game::initAudio()
 {
-    m_audio_player = Engine::AudioManager::Get().make_audioPlayer("Greenpath.mp3", 1.0f, true);
+    // La banda sonora va en streaming: no se decodifica entera en RAM
+    m_music_clip = AudioSystem::Get().addAudio("Greenpath.mp3", true);
+}
+
+void Game::playMusic()
+{
+    auto& audio = AudioSystem::Get();
+    if(audio.isPlaying(m_music))
+        return;
+
+    VoiceParams params;
+    params.loop = true;
+    params.spatial = false;
+    params.priority = 100;  // La música no se roba nunca por efectos
+
+    m_music = audio.play(m_music_clip, params);
 }
 
 void Game::initSkyBox()
@@ -119,93 +210,52 @@ void Game::initSkyBox()
 
 void Game::Level1()
 {
-    Level level1(m_scene, m_user_index);
-
-    ObstacleSettings s_ground;;
-
-    s_ground.box_shape = {5.f, 0.5f, 5.f};
-    s_ground.body_type = Engine::BodyType::Static;
-    s_ground.onContactStart = ground_collition;
-    s_ground.user_index = m_user_index;
-    s_ground.scale = {5.f, 1.f, 5.f};
-
-
-    ObstacleSettings s_casita = {};
-
-    s_casita.scale = {3.f, 3.f, 3.f};
-    s_casita.box_shape = {2.f, 1.5f, 2.f};
-    s_casita.rel_pos = {0.f, -0.75f, 0.f};
-    s_casita.body_type = Engine::BodyType::Static;
-
-    ObstacleSettings s_plataforma = {};
-
-    s_plataforma.scale = {1.f, 1.f, 1.f};
-    s_plataforma.box_shape = {1.f, 0.25f, 1.f};
-    s_plataforma.body_type = Engine::BodyType::Kinematic;
-    s_plataforma.onContactStart = ground_collition;
-    s_plataforma.user_index = m_user_index;
-    s_plataforma.rel_pos = {0.f, -0.25f, 0.f};
-
-    ObstacleSettings s_plataforma2 = s_plataforma;
-
-    s_plataforma2.script = "PlataformaMovil";
-    s_plataforma2.script_params = {0.f, 3.f, "vertical"};
-
-    ObstacleSettings s_plataforma3 = s_plataforma;
-    s_plataforma3.script = "PlataformaMovil";
-    s_plataforma3.script_params = {-3.f, 3.f, "horizontal"};
-
-    ObstacleSettings s_bird = s_plataforma3;
-    s_bird.box_shape = {0.5f, 0.5f, 0.5f};
-    s_bird.scale = {0.5f, 0.5f, 0.5f};
-    s_bird.axis = {0.f, 1.f, 0.f};
-    s_bird.angle = -90.f;
-    s_bird.script = "Enemy";
-    s_bird.script_params = {-3.f, 3.f, 2.f};
-    s_bird.onContactStart = enemy_collition;
-
-
-    ObstacleSettings s_parachute = {};
-    s_parachute.box_shape = {1.5f, 1.5f, 1.5f};
-    s_parachute.rel_pos = {0.f, -1.f, 0.f};
-    s_parachute.body_type = Engine::BodyType::Kinematic;
-    s_parachute.scale = {2.5f, 2.5f, 2.5f};
-
-    s_parachute.script = "Parachute";
-    s_parachute.script_params = {&parachute_collisioning, m_input.get(), m_user.get()};
-    s_parachute.user_index = m_user_index;
-
-    s_parachute.onContactStart = parachute_collision_on;
-    s_parachute.onContactEnd = parachute_collision_off;
-
-    ObstacleSettings s_goal = s_ground;
-
-    s_goal.box_shape = {2.f, 0.5f, 2.f};
-    s_goal.scale = {2.f, 0.5f, 2.f};
-    s_goal.onContactStart = goal_collition;
-
-
-    level1.init({
-        {"casita/base.fbx", "deco", {2.f, 1.8f, 0.f}, s_casita}, 
-        {"ground/base.fbx", "ground", {0.f, -0.5f, 0.f}, s_ground},
-        {"ground/base.fbx", "plataforma", {-2.f, -0.5f, 7.f}, s_plataforma},
-        {"ground/base.fbx", "plataforma", {-2.f, -0.5f, 10.f}, s_plataforma},
-        {"ground/base.fbx", "plataforma", {-2.f, -0.5f, 14.f}, s_plataforma},
-        {"ground/base.fbx", "plataforma", {-2.f, -0.5f, 16.f}, s_plataforma2},
-        {"ground/base.fbx", "plataforma", {-2.f, 3.f, 20.f}, s_plataforma},
-        {"ground/base.fbx", "plataforma", {-2.f, 3.f, 24.f}, s_plataforma},
-        {"ground/base.fbx", "plataforma", {0.f, 3.f, 30.f}, s_plataforma},
-        {"ground/base.fbx", "plataforma", {-3.f, 3.f, 34.f}, s_plataforma3},
-        {"ground/base.fbx", "plataforma", {3.f, 3.f, 38.f}, s_plataforma3},
-        {"ground/base.fbx", "plataforma", {-3.f, 3.f, 42.f}, s_plataforma3},
-        {"ground/base.fbx", "plataforma", {3.f, 3.f, 46.f}, s_plataforma3},
-        {"", "plataforma", {-3.f, 3.f, 50.f}, s_plataforma},
-        {"bird/base.fbx", "enemey", {-3.f, 5.f, 53.f}, s_bird},
-        {"parachute/base.fbx", "parachute", {0.f, 5.f, 57.f}, s_parachute},
-        {"bird/base.fbx", "enemey", {-3.f, 5.f, 70.f}, s_bird},
-         {"ground/base.fbx", "goal", {10.f, -5.5f, 100.f}, s_goal},
-    });
+    // El nivel está en assets/levels/level1.txt; el binario se regenera si la fuente es más nueva
+    auto source = ASSETS_PATH / "levels" / "level1.txt";
+    auto binary = ASSETS_PATH / "levels" / "level1.lvl";
+
+    if(!LevelCompiler().cook(source, binary))
+    {
+        std::cerr << "[Game] No se pudo compilar " << source << std::endl;
+        return;
+    }
 
+    RegisterScripts();
+
+    LevelBindings bindings;
+    bindings.user_index = m_user_index;
+    bindings.character = m_character;
+    bindings.callbacks = {
+        {"enemy", enemy_collition},
+        {"parachute_on", parachute_collision_on},
+        {"parachute_off", parachute_collision_off},
+        {"goal", goal_collition},
+        {"checkpoint", checkpoint_reached},
+    };
+    bindings.scripts = {
+        {"parachute", ScriptSpec::make<Parachute>({&parachute_collisioning, m_input.get()})},
+    };
+
+    // Sólo quedan cargados los chunks cercanos al jugador
+    m_streamer = std::make_shared<LevelStreamer>(m_scene);
+    if(!m_streamer->open(binary.string(), bindings))
+    {
+        std::cerr << "[Game] No se pudo cargar " << binary << std::endl;
+        m_streamer.reset();
+        return;
+    }
+
+    m_streamer->warmup(m_spawn);
+    m_user->addScript(std::make_shared<LevelStreamerClock>(m_streamer));
+
+    // Jugador y chunks cargados alrededor del spawn; los objetos de los chunks los guarda el streamer
+    for(auto* snapshot : {&m_level_start, &m_checkpoint})
+    {
+        snapshot->track(m_user);
+        snapshot->track(m_streamer);
+    }
+
+    m_level_start.capture();
 }
 
 void Game::render()
@@ -215,16 +265,12 @@ void Game::render()
 
 void Game::initCollitions()
 {
-    ground_collition = [this]() {
-        // Aquí puedes ejecutar lógica como aplicar daño o activar efectos
-        m_input->setJumping(false);
-    };
-
     enemy_collition = [this]() {
         std::cout << "=============GAME OVER=============" << std::endl;
         
         // Mostrar el menú de Game Over
-        m_ui_manager->ShowTemplate("gameover");
+        setLives(0);
+        m_ui_layer->show("gameover");
         
         //m_input->setOnGameOver(nullptr);
 
@@ -244,18 +290,90 @@ void Game::initCollitions()
     goal_collition = [this]()
     {
         std::cout << "=============YOU WIN=============" << std::endl;
-        m_ui_manager->ShowTemplate("you_win");
+        m_ui_layer->show("you_win");
         m_renderer->pause(true);
     };
 
+    // Se llama en el hilo de juego después del paso de la física: se puede capturar aquí
+    checkpoint_reached = [this]()
+    {
+        m_checkpoint.capture();
+    };
+
+    m_projectiles->setOnHit([this](const ProjectileHit& hit) { bulletHit(hit); });
+
 }
 
 void Game::restart()
 {
-    m_input->setJumping(false);
-    m_user->getBody()->SetPosition({-2.f, 0.f, 0.f});
-    m_user->getBody()->SetVelocity({0.f, 0.f, 0.f});
-    m_audio_player->play();
+    parachute_collisioning = false;
+    m_projectiles->clear();
+    m_checkpoint.discard();
+
+    // Jugador, chunks, plataformas, enemigos y scripts vuelven al estado recién cargado sin tocar assets
+    if(!m_level_start.restore())
+        resetPlayer();
+
+    setLives(1);
+    playMusic();
+}
+
+void Game::respawn()
+{
+    parachute_collisioning = false;
+    m_projectiles->clear();
+
+    // Sin checkpoint alcanzado se empieza el nivel de nuevo
+    if(!m_checkpoint.restore())
+    {
+        restart();
+        return;
+    }
+
+    setLives(1);
+    playMusic();
+}
+
+void Game::resetPlayer()
+{
+    // Sin snapshot: el jugador vuelve al spawn y el nivel se descarga y se vuelve a cargar
+    m_character->setPosition(m_spawn);
+    m_character->setLinearVelocity({0.f, 0.f, 0.f});
+    Triggers::Get().ResetOverlaps();
+
+    if(m_streamer)
+    {
+        m_streamer->reset();
+        m_streamer->warmup(m_spawn);
+    }
+}
+
+void Game::fire()
+{
+    // Desde la altura del pecho hacia donde mira la cámara; el rayo ignora el cuerpo del jugador
+    glm::vec3 forward = glm::normalize(m_camera->getForward());
+    glm::vec3 origin = m_user->getTransform()->getPosition() + glm::vec3(0.f, 0.3f, 0.f);
+
+    auto body = m_user->getBody();
+    m_projectiles->spawn(origin, forward * BulletSpeed, body ? BodyIDs::Get().Find(body) : JPH::BodyID());
+}
+
+void Game::bulletHit(const ProjectileHit& hit)
+{
+    // Las balas no ven sensores (la meta, el paracaídas): sólo reaccionan los enemigos
+    auto& bodies = Engine::Physics::Get().GetBodyInterface();
+    if(!m_streamer || CollisionLayers::FromObjectLayer(bodies.GetObjectLayer(hit.body)) != CollisionLayers::Get().Find("enemey"))
+        return;
+
+    // Abatido hasta que su chunk se vuelva a cargar o se reinicie el nivel
+    m_streamer->hide(hit.body);
+}
+
+void Game::setLives(int lives)
+{
+    // Sólo toca el DOM si el valor cambia
+    if(m_lives)
+        m_lives->set(lives);
 }
 
 
@@ -265,7 +383,8 @@ void Game::handleGameOver() noexcept
         std::cout << "=============GAME OVER=============" << std::endl;
         
         // Mostrar el menú de Game Over
-        m_ui_manager->ShowTemplate("gameover");
+        setLives(0);
+        m_ui_layer->show("gameover");
         
         //m_input->setOnGameOver(nullptr);
 
@@ -280,10 +399,18 @@ void Game::initUI()
 {
     // Inicializar UIManager
     m_ui_manager = std::make_shared<UIManager>();
+    m_ui_layer = std::make_unique<UILayer>(m_ui_manager, m_renderer);
     if (m_ui_manager->Initialize(m_window, "ui"))
     {
+        // El data model tiene que existir antes de cargar los documentos que lo usan
+        m_hud = std::make_unique<UIDataModel>(m_ui_manager->GetContext(), "hud");
+        m_lives = m_hud->bind<int>("lives", 1);
+        m_latency_text = m_hud->bind<std::string>("latency");
+        m_ui_layer->watch(m_hud.get());
+
         // Cargar plantillas
-        m_ui_manager->LoadTemplate("main_menu", "test.rml", true); // Mostrar automáticamente
+        m_ui_manager->LoadTemplate("hud", "lives_counter.rml", false);
+        m_ui_manager->LoadTemplate("main_menu", "test.rml", false); // Se muestra al conectar la capa
         m_ui_manager->LoadTemplate("pause_menu", "pause_menu.rml", false); // Cargar pero no mostrar
         m_ui_manager->LoadTemplate("gameover", "gameover.rml", false); // Cargar pero no mostrar
         m_ui_manager->LoadTemplate("you_win", "you_win.rml", false); // Cargar pero no mostrar
@@ -293,9 +420,10 @@ void Game::initUI()
         m_ui_manager->RegisterEvent("main_menu", "start-button", Rml::EventId::Click, 
             [this](Rml::Element*, Rml::EventId) {
                 std::cout << "Botón START GAME presionado" << std::endl;
-                m_ui_manager->HideTemplate("main_menu");
+                m_ui_layer->hide("main_menu");
+                m_ui_layer->show("hud");
                 m_renderer->pause(false);
-                m_audio_player->play();
+                playMusic();
                 std::cout << "Juego iniciado desde el menú" << std::endl;
             });
         
@@ -303,7 +431,7 @@ void Game::initUI()
         m_ui_manager->RegisterEvent("pause_menu", "continue-button", Rml::EventId::Click,
             [this](Rml::Element*, Rml::EventId) {
                 std::cout << "Botón CONTINUAR presionado" << std::endl;
-                m_ui_manager->HideTemplate("pause_menu");
+                m_ui_layer->hide("pause_menu");
                 m_renderer->pause(false);
             });
         
@@ -311,7 +439,7 @@ void Game::initUI()
         m_ui_manager->RegisterEvent("pause_menu", "restart-button", Rml::EventId::Click,
             [this](Rml::Element*, Rml::EventId) {
                 std::cout << "Botón REINICIAR JUEGO presionado" << std::endl;
-                m_ui_manager->HideTemplate("pause_menu");
+                m_ui_layer->hide("pause_menu");
                 restart();
                 m_renderer->pause(false);
             });
@@ -321,8 +449,8 @@ void Game::initUI()
         m_ui_manager->RegisterEvent("gameover", "restart-button", Rml::EventId::Click,
             [this](Rml::Element*, Rml::EventId) {
                 std::cout << "Botón REINICIAR presionado (Game Over)" << std::endl;
-                m_ui_manager->HideTemplate("gameover");
-                restart();
+                m_ui_layer->hide("gameover");
+                respawn();
                 m_renderer->pause(false);
             });
         
@@ -330,9 +458,10 @@ void Game::initUI()
         m_ui_manager->RegisterEvent("gameover", "main-menu-button", Rml::EventId::Click,
             [this](Rml::Element*, Rml::EventId) {
                 std::cout << "Botón MAIN MENU presionado (Game Over)" << std::endl;
-                m_ui_manager->HideTemplate("gameover");
+                m_ui_layer->hide("gameover");
                 restart();
-                m_ui_manager->ShowTemplate("main_menu");
+                m_ui_layer->hide("hud");
+                m_ui_layer->show("main_menu");
             });
         
         // Botón SALIR
@@ -347,7 +476,7 @@ void Game::initUI()
         m_ui_manager->RegisterEvent("you_win", "restart-button", Rml::EventId::Click,
             [this](Rml::Element*, Rml::EventId) {
                 std::cout << "Botón REINICIAR presionado (You Win)" << std::endl;
-                m_ui_manager->HideTemplate("you_win");
+                m_ui_layer->hide("you_win");
                 restart();
                 m_renderer->pause(false);
             });
@@ -356,28 +485,29 @@ void Game::initUI()
         m_ui_manager->RegisterEvent("you_win", "main-menu-button", Rml::EventId::Click,
             [this](Rml::Element*, Rml::EventId) {
                 std::cout << "Botón MAIN MENU presionado (You Win)" << std::endl;
-                m_ui_manager->HideTemplate("you_win");
+                m_ui_layer->hide("you_win");
                 restart();
-                m_ui_manager->ShowTemplate("main_menu");
+                m_ui_layer->hide("hud");
+                m_ui_layer->show("main_menu");
             });
         
-        // Conectar UIManager al renderer
-        m_renderer->setUIManager(m_ui_manager);
+        // La capa conecta el UIManager al renderer sólo mientras haya algo visible
+        m_ui_layer->show("main_menu");
 
         m_input->setOnPause([this]() {
             std::cout << "Botón PAUSE presionado (Game Over)" << std::endl;
-                if (!m_ui_manager->IsTemplateVisible("main_menu"))
+                if (!m_ui_layer->isVisible("main_menu"))
                 {
                     // Si el menú de pausa está visible, ocultarlo (reanudar)
-                    if(m_ui_manager->IsTemplateVisible("pause_menu"))
+                    if(m_ui_layer->isVisible("pause_menu"))
                     {
-                        m_ui_manager->HideTemplate("pause_menu");
+                        m_ui_layer->hide("pause_menu");
                         m_renderer->pause(false);
                     }
                     // Si no está visible, mostrarlo (pausar)
                     else
                     {
-                        m_ui_manager->ShowTemplate("pause_menu");
+                        m_ui_layer->show("pause_menu");
                         m_renderer->pause(true);
                     }
                 }
@@ -401,6 +531,28 @@ void Game::resetGame() noexcept
     // Por ahora solo imprimimos el mensaje
 }
 
+void Game::enablePhysicsStats(float report_interval)
+{
+    if(m_physics_monitor)
+        return;
+
+    m_physics_monitor = std::make_shared<PhysicsMonitor>(report_interval);
+    m_user->addScript(m_physics_monitor);
+}
+
+void Game::enableLatencyStats(float report_interval)
+{
+    if(m_latency_monitor)
+        return;
+
+    m_latency_monitor = std::make_shared<LatencyMonitor>(report_interval, m_latency_text);
+    m_user->addScript(m_latency_monitor);
+
+    m_input->setOnInputConsumed([monitor = m_latency_monitor.get()](double input_time) {
+        monitor->consumed(input_time);
+    });
+}
+
 void Game::shutdownUI() noexcept
 {
     // Hacer shutdown explícito de UIManager antes de que se destruya Game
@@ -408,9 +560,9 @@ void Game::shutdownUI() noexcept
     if (m_ui_manager && m_ui_manager->IsInitialized())
     {
         // Desconectar UIManager del renderer primero
-        if (m_renderer)
+        if (m_ui_layer)
         {
-            m_renderer->setUIManager(nullptr);
+            m_ui_layer->detach();
         }
         
         try
@@ -422,6 +574,13 @@ void Game::shutdownUI() noexcept
             // llamamos a Shutdown() y la librería se encarga del resto
             m_ui_manager->Shutdown();
             std::cout << "UIManager shutdown completado" << std::endl;
+
+            // El contexto ya no lee las variables del HUD
+            m_lives = nullptr;
+            m_latency_text = nullptr;
+            if(m_latency_monitor)
+                m_latency_monitor->setOverlay(nullptr);
+            m_hud.reset();
         }
         catch (const std::exception& e)
         {
@@ -0,0 +1,77 @@
+#include <GLFW/glfw3.h>
+
+#include "InputQueue.hpp"
+
+
+InputQueue& InputQueue::Get()
+{
+    static InputQueue instance;
+    return instance;
+}
+
+void InputQueue::attach(GLFWwindow* window)
+{
+    if(!window)
+        return;
+
+    m_next_key = glfwSetKeyCallback(window, &InputQueue::onKey);
+    m_next_mouse_button = glfwSetMouseButtonCallback(window, &InputQueue::onMouseButton);
+    m_next_cursor = glfwSetCursorPosCallback(window, &InputQueue::onCursorPos);
+}
+
+void InputQueue::takeMouseDelta(double& dx, double& dy)
+{
+    dx = m_mouse_dx;
+    dy = m_mouse_dy;
+    m_mouse_dx = m_mouse_dy = 0.0;
+}
+
+void InputQueue::clear()
+{
+    m_events.clear();
+    m_mouse_dx = m_mouse_dy = 0.0;
+}
+
+void InputQueue::push(const InputEvent& event)
+{
+    if(m_events.size() == MaxEvents)
+        m_events.pop_front();
+
+    m_events.push_back(event);
+}
+
+void InputQueue::onKey(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    auto& queue = Get();
+    queue.push({InputEvent::Type::Key, key, action, mods, glfwGetTime()});
+
+    if(queue.m_next_key)
+        queue.m_next_key(window, key, scancode, action, mods);
+}
+
+void InputQueue::onMouseButton(GLFWwindow* window, int button, int action, int mods)
+{
+    auto& queue = Get();
+    queue.push({InputEvent::Type::MouseButton, button, action, mods, glfwGetTime()});
+
+    if(queue.m_next_mouse_button)
+        queue.m_next_mouse_button(window, button, action, mods);
+}
+
+void InputQueue::onCursorPos(GLFWwindow* window, double x, double y)
+{
+    auto& queue = Get();
+
+    // Se suman todos los movimientos del frame, no sólo el último
+    if(queue.m_has_cursor)
+    {
+        queue.m_mouse_dx += x - queue.m_cursor_x;
+        queue.m_mouse_dy += queue.m_cursor_y - y;
+    }
+    queue.m_cursor_x = x;
+    queue.m_cursor_y = y;
+    queue.m_has_cursor = true;
+
+    if(queue.m_next_cursor)
+        queue.m_next_cursor(window, x, y);
+}
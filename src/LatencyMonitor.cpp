@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <GLFW/glfw3.h>
+
+#include "LatencyMonitor.hpp"
+
+
+LatencyMonitor::LatencyMonitor(float report_interval, UIValue<std::string>* overlay)
+    : m_report_interval(report_interval), m_overlay(overlay)
+{
+}
+
+LatencyMonitor::~LatencyMonitor()
+{
+    for(auto& frame : m_frames)
+        glDeleteSync(frame.fence);
+}
+
+void LatencyMonitor::consumed(double input_time)
+{
+    Pending pending;
+    pending.input = input_time;
+    pending.consumed = glfwGetTime();
+    m_consumed.push_back(pending);
+}
+
+LatencyStats LatencyMonitor::getPercentile(float percentile) const
+{
+    LatencyStats result;
+    if(m_samples.empty())
+        return result;
+
+    std::vector<float> values(m_samples.size());
+    size_t n = std::min(values.size() - 1, size_t(percentile / 100.f * float(values.size())));
+
+    auto pick = [&](float LatencyStats::* stage) {
+        std::transform(m_samples.begin(), m_samples.end(), values.begin(), [stage](const LatencyStats& s) { return s.*stage; });
+        std::nth_element(values.begin(), values.begin() + n, values.end());
+        return values[n];
+    };
+
+    result.simulation = pick(&LatencyStats::simulation);
+    result.submit = pick(&LatencyStats::submit);
+    result.swap = pick(&LatencyStats::swap);
+    result.gpu = pick(&LatencyStats::gpu);
+    return result;
+}
+
+void LatencyMonitor::print(std::ostream& out) const
+{
+    if(m_samples.empty())
+        return;
+
+    auto line = [&out](const char* name, const LatencyStats& stats) {
+        out << " | " << name << " sim " << stats.simulation << " envío " << stats.submit
+            << " swap<= " << stats.swap << " gpu<= " << stats.gpu;
+    };
+
+    out << std::fixed << std::setprecision(1) << "[Latency] " << m_samples.size() << " muestras (ms)";
+    line("p50", getPercentile(50.f));
+    line("p95", getPercentile(95.f));
+    line("p99", getPercentile(99.f));
+    out << std::defaultfloat << std::endl;
+}
+
+void LatencyMonitor::OnUpdate(const GLfloat& dt)
+{
+    double now = glfwGetTime();
+
+    // Lo enviado el frame anterior ya pasó por swap_buffers en algún momento desde
+    // entonces: el swap y la fence se marcan aquí, un frame tarde
+    if(!m_submitted.empty())
+    {
+        for(auto& pending : m_submitted)
+            pending.swapped = now;
+
+        Frame frame;
+        frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        frame.pending = std::move(m_submitted);
+        m_frames.push_back(std::move(frame));
+        m_submitted.clear();
+    }
+
+    poll(now);
+
+    // Lo consumido en este frame se dibuja a continuación
+    for(auto& pending : m_consumed)
+        pending.submitted = now;
+    m_submitted.insert(m_submitted.end(), m_consumed.begin(), m_consumed.end());
+    m_consumed.clear();
+
+    if(m_report_interval <= 0.f)
+        return;
+
+    m_report_timer += dt;
+    if(m_report_timer >= m_report_interval)
+    {
+        m_report_timer = 0.f;
+        report();
+    }
+}
+
+void LatencyMonitor::poll(double now)
+{
+    auto ms = [](double from, double to) { return float((to - from) * 1000.0); };
+
+    // Las fences se completan en orden, basta con mirar la más antigua
+    while(!m_frames.empty())
+    {
+        Frame& frame = m_frames.front();
+        GLenum status = glClientWaitSync(frame.fence, 0, 0);
+        if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            break;
+
+        for(auto& pending : frame.pending)
+        {
+            LatencyStats stats;
+            stats.simulation = ms(pending.input, pending.consumed);
+            stats.submit = ms(pending.input, pending.submitted);
+            stats.swap = ms(pending.input, pending.swapped);
+            stats.gpu = ms(pending.input, now);
+
+            if(m_samples.size() == MaxSamples)
+                m_samples.pop_front();
+            m_samples.push_back(stats);
+        }
+
+        glDeleteSync(frame.fence);
+        m_frames.pop_front();
+    }
+}
+
+void LatencyMonitor::report()
+{
+    print(std::cout);
+
+    if(!m_overlay || m_samples.empty())
+        return;
+
+    LatencyStats p50 = getPercentile(50.f);
+    LatencyStats p95 = getPercentile(95.f);
+
+    std::ostringstream text;
+    // La etapa gpu es una cota superior
+    text << std::fixed << std::setprecision(1) << "input <= " << p50.gpu << " ms (p95 <= " << p95.gpu << ")";
+    m_overlay->set(text.str());
+}
@@ -6,6 +6,13 @@
 #include <GLS/Physics.hpp>
 
 #include "Level.hpp"
+#include "LevelFile.hpp"
+
+
+// Level::load convierte el tipo del fichero al del registro con un cast
+static_assert(uint8_t(ParamType::Float) == uint8_t(LevelFormat::ParamType::Float));
+static_assert(uint8_t(ParamType::Int) == uint8_t(LevelFormat::ParamType::Int));
+static_assert(uint8_t(ParamType::Bool) == uint8_t(LevelFormat::ParamType::Bool));
 
 
 Level::Level(std::shared_ptr<Engine::Scene> scene, unsigned user_index): scene(scene), user_index(user_index)
@@ -20,21 +27,252 @@ Level::~Level()
 
 void Level::init(const init_list& list)
 {
+    obstacles.reserve(obstacles.size() + list.size());
     for (auto& obs : list)
+        spawn(obs.filename, obs.tag, obs.pos, obs.settings);
+}
+
+std::shared_ptr<Obstacle> Level::spawn(const std::string& filename, const std::string& tag, const glm::vec3& pos, const ObstacleSettings& settings)
+{
+    std::shared_ptr<Obstacle> obstacle;
+
+    auto it = tags_map.find(tag);
+    if(it == tags_map.end())
+    {
+        obstacle = std::make_shared<Obstacle>(scene, filename, tag, pos, settings);
+        tags_map.insert({tag, obstacle->m_index});
+    }else
+        obstacle = std::make_shared<Obstacle>(scene, it->second, tag, pos, settings);
+
+    obstacles.push_back(obstacle);
+    return obstacle;
+}
+
+namespace
+{
+    glm::vec3 vec3(const float* v)
+    {
+        return glm::vec3(v[0], v[1], v[2]);
+    }
+
+    // Spec del script con sus parámetros del fichero y, después, los extra (los extra mandan)
+    bool scriptSpec(const LevelFile& file, const LevelFormat::Script& script, std::span<const LevelFormat::Param> extra, ScriptSpec& spec)
+    {
+        auto params = file.params();
+        std::string_view name = file.str(script.name);
+
+        ScriptId id = ScriptRegistry::Get().find(std::string(name));
+        if(id == InvalidScript || script.first_param > params.size() || script.param_count > params.size() - script.first_param)
+        {
+            std::cerr << "[Level] Script desconocido o parámetros inválidos: " << name << std::endl;
+            return false;
+        }
+
+        std::vector<ParamValue> values;
+        values.reserve(script.param_count + extra.size());
+
+        auto add = [&](const LevelFormat::Param& p) {
+            ParamValue value;
+            value.name = file.str(p.name);
+            value.type = ParamType(p.type);
+            value.i = p.i;
+            values.push_back(value);
+        };
+
+        for(const auto& p : params.subspan(script.first_param, script.param_count))
+            add(p);
+        for(const auto& p : extra)
+            add(p);
+
+        spec = ScriptRegistry::Get().makeSpec(id, values);
+        return spec.valid();
+    }
+}
+
+bool Level::load(const LevelFile& file, const LevelBindings& bindings)
+{
+    std::vector<std::shared_ptr<const Prefab>> prefabs;
+    if(!resolve(file, bindings, prefabs))
+        return false;
+
+    auto placements = file.placements();
+    obstacles.reserve(obstacles.size() + placements.size());
+
+    PrefabOverrides overrides;
+    for(const auto& place : placements)
+    {
+        if(place.prefab >= prefabs.size())
+        {
+            std::cerr << "[Level] Prefab fuera de rango en una colocación" << std::endl;
+            return false;
+        }
+
+        bool modified = place.override != LevelFormat::NoIndex;
+        if(modified && !resolveOverrides(file, place, overrides))
+            return false;
+
+        instantiate(*prefabs[place.prefab], vec3(place.pos), modified ? &overrides : nullptr);
+    }
+
+    return true;
+}
+
+std::shared_ptr<Obstacle> Level::instantiate(const Prefab& prefab, const glm::vec3& pos, const PrefabOverrides* overrides)
+{
+    auto obstacle = PrefabLibrary::Get().instantiate(scene, prefab, pos, overrides);
+    obstacles.push_back(obstacle);
+    return obstacle;
+}
+
+bool Level::resolveOverrides(const LevelFile& file, const LevelFormat::Placement& place, PrefabOverrides& overrides)
+{
+    auto records = file.overrides();
+    auto prefabs = file.prefabs();
+    if(place.override >= records.size() || place.prefab >= prefabs.size())
+    {
+        std::cerr << "[Level] Override fuera de rango en una colocación" << std::endl;
+        return false;
+    }
+
+    const auto& r = records[place.override];
+    overrides = {};
+
+    if(r.fields & LevelFormat::OverrideScale)
+    {
+        overrides.fields |= PrefabOverrides::Scale;
+        overrides.scale = vec3(r.scale);
+    }
+
+    if(r.fields & LevelFormat::OverrideRotation)
     {
-        auto it = tags_map.find(obs.tag);
-        if(it == tags_map.end())
+        overrides.fields |= PrefabOverrides::Rotation;
+        overrides.axis = vec3(r.axis);
+        overrides.angle = r.angle;
+    }
+
+    if(r.fields & LevelFormat::OverrideParams)
+    {
+        auto scripts = file.scripts();
+        auto params = file.params();
+        uint32_t script = prefabs[place.prefab].settings.script;
+
+        if(script >= scripts.size() || r.first_param > params.size() || r.param_count > params.size() - r.first_param)
         {
-            auto obstacle = std::make_shared<Obstacle>(scene, obs.filename, obs.tag, obs.pos, obs.settings);
-            obstacles.push_back(obstacle);
-            tags_map.insert({obs.tag, obstacle->m_index});
-        }else{
-            auto obstacle = std::make_shared<Obstacle>(scene, it->second, obs.tag, obs.pos, obs.settings);
-            obstacles.push_back(obstacle);
+            std::cerr << "[Level] Parámetros de override inválidos" << std::endl;
+            return false;
         }
+
+        if(!scriptSpec(file, scripts[script], params.subspan(r.first_param, r.param_count), overrides.script))
+            return false;
+
+        overrides.fields |= PrefabOverrides::Script;
     }
 
-    scene->at(user_index)->getBody()->constraintRotation(obstacles[0]->m_object->getBody());
+    return true;
 }
 
+bool Level::resolve(const LevelFile& file, const LevelBindings& bindings, std::vector<std::shared_ptr<const Prefab>>& prefabs)
+{
+    if(!file.isOpen())
+        return false;
+
+    auto callback = [&](const LevelFormat::String& ref, Engine::Listener::Callback& out) {
+        std::string_view name = file.str(ref);
+        if(name.empty())
+            return true;
+
+        auto it = bindings.callbacks.find(std::string(name));
+        if(it == bindings.callbacks.end())
+        {
+            std::cerr << "[Level] Callback desconocido: " << name << std::endl;
+            return false;
+        }
+
+        out = it->second;
+        return true;
+    };
 
+    // Cada prefab se resuelve una vez; las colocaciones sólo lo indexan
+    auto records = file.prefabs();
+    auto scripts = file.scripts();
+    auto& library = PrefabLibrary::Get();
+
+    prefabs.clear();
+    prefabs.reserve(records.size());
+
+    for(size_t i = 0; i < records.size(); i++)
+    {
+        const auto& record = records[i];
+        std::string name(file.str(record.name));
+
+        // Compartido con otros niveles: el primero que lo define manda
+        if(auto prefab = library.find(name))
+        {
+            prefabs.push_back(prefab);
+            continue;
+        }
+
+        const auto& r = record.settings;
+        ObstacleSettings s;
+
+        s.box_shape = JPH::Vec3(r.box_shape[0], r.box_shape[1], r.box_shape[2]);
+        s.rel_pos = vec3(r.rel_pos);
+        s.rel_scale = vec3(r.rel_scale);
+        s.rel_axis = vec3(r.rel_axis);
+        s.rel_angle = r.rel_angle;
+        s.scale = vec3(r.scale);
+        s.axis = vec3(r.axis);
+        s.angle = r.angle;
+        s.sensor = r.sensor != 0;
+        s.layer = std::string(file.str(r.layer));
+        s.user_index = bindings.user_index;
+
+        switch(LevelFormat::BodyType(r.body_type))
+        {
+            case LevelFormat::BodyType::Static: s.body_type = Engine::BodyType::Static; break;
+            case LevelFormat::BodyType::Kinematic: s.body_type = Engine::BodyType::Kinematic; break;
+            default: s.body_type = Engine::BodyType::Dynamic; break;
+        }
+
+        if(r.character)
+            s.character = bindings.character;
+
+        if(!callback(r.on_start, s.onContactStart) || !callback(r.on_end, s.onContactEnd))
+            return false;
+
+        if(r.script != LevelFormat::NoIndex)
+        {
+            if(r.script >= scripts.size())
+            {
+                std::cerr << "[Level] Script fuera de rango en el prefab " << name << std::endl;
+                return false;
+            }
+
+            const auto& script = scripts[r.script];
+            std::string_view script_name = file.str(script.name);
+
+            if(!script_name.empty() && script_name[0] == '@')
+            {
+                auto it = bindings.scripts.find(std::string(script_name.substr(1)));
+                if(it == bindings.scripts.end())
+                {
+                    std::cerr << "[Level] Script del juego desconocido: " << script_name << std::endl;
+                    return false;
+                }
+
+                s.script = it->second;
+            }else if(!scriptSpec(file, script, {}, s.script))
+                return false;
+        }
+
+        auto prefab = std::make_shared<const Prefab>(name, std::string(file.str(record.model)), std::string(file.str(record.tag)), std::move(s));
+        prefabs.push_back(library.add(std::move(prefab)));
+    }
+
+    return true;
+}
+
+const std::vector<std::shared_ptr<Obstacle>>& Level::getObstacles() const
+{
+    return obstacles;
+}
@@ -0,0 +1,511 @@
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "LevelCompiler.hpp"
+
+
+namespace
+{
+    LevelFormat::Settings defaultSettings()
+    {
+        // Mismos valores por defecto que ObstacleSettings
+        LevelFormat::Settings s{};
+        s.rel_scale[0] = s.rel_scale[1] = s.rel_scale[2] = 1.f;
+        s.rel_axis[1] = 1.f;
+        s.scale[0] = s.scale[1] = s.scale[2] = 1.f;
+        s.axis[1] = 1.f;
+        s.script = LevelFormat::NoIndex;
+        s.body_type = uint8_t(LevelFormat::BodyType::Dynamic);
+        return s;
+    }
+
+    bool parseFloat(std::string_view token, float& value)
+    {
+        // from_chars de float no está en todas las bibliotecas estándar; strtof
+        // necesita el token terminado en '\0' y tiene que consumirlo entero
+        if(token.empty())
+            return false;
+
+        std::string text(token);
+        char* end = nullptr;
+        errno = 0;
+        value = std::strtof(text.c_str(), &end);
+        return errno != ERANGE && end == text.c_str() + text.size();
+    }
+
+    // "x,y,z"
+    bool parseVec3(std::string_view token, float* value)
+    {
+        for(int i = 0; i < 3; i++)
+        {
+            auto comma = token.find(',');
+            if((comma == std::string_view::npos) != (i == 2))
+                return false;
+
+            if(!parseFloat(token.substr(0, comma), value[i]))
+                return false;
+
+            if(i < 2)
+                token.remove_prefix(comma + 1);
+        }
+        return true;
+    }
+
+    bool parseParam(const std::string& value, LevelFormat::Param& param)
+    {
+        if(value == "true" || value == "false")
+        {
+            param.type = uint8_t(LevelFormat::ParamType::Bool);
+            param.i = value == "true";
+            return true;
+        }
+
+        const char* end = value.data() + value.size();
+        int32_t i;
+        auto result = std::from_chars(value.data(), end, i);
+        if(result.ec == std::errc() && result.ptr == end)
+        {
+            param.type = uint8_t(LevelFormat::ParamType::Int);
+            param.i = i;
+            return true;
+        }
+
+        param.type = uint8_t(LevelFormat::ParamType::Float);
+        return parseFloat(value, param.f);
+    }
+
+    // Ficheros que incluye source con use, recursivamente (sólo lee esas líneas)
+    void dependencies(const std::filesystem::path& source, std::vector<std::filesystem::path>& out)
+    {
+        std::error_code ec;
+        auto path = std::filesystem::weakly_canonical(source, ec);
+        for(auto& seen : out)
+            if(seen == path)
+                return;
+
+        out.push_back(path);
+
+        std::ifstream in(source);
+        std::string line;
+        while(std::getline(in, line))
+        {
+            std::istringstream tokens(line);
+            std::string cmd, file;
+            if(tokens >> cmd >> file && cmd == "use")
+                dependencies(source.parent_path() / file, out);
+        }
+    }
+}
+
+void LevelCompiler::clear()
+{
+    m_prefabs.clear();
+    m_prefab_names.clear();
+    m_overrides.clear();
+    m_placements.clear();
+    m_sources.clear();
+    m_chars.clear();
+    m_strings.clear();
+}
+
+bool LevelCompiler::compile(const std::filesystem::path& source, const std::filesystem::path& output)
+{
+    clear();
+
+    if(!parse(source))
+        return false;
+
+    return write(output);
+}
+
+bool LevelCompiler::cook(const std::filesystem::path& source, const std::filesystem::path& output)
+{
+    std::error_code ec;
+    if(std::filesystem::exists(output, ec))
+    {
+        if(!std::filesystem::exists(source, ec))
+            return true;
+
+        std::vector<std::filesystem::path> sources;
+        dependencies(source, sources);
+
+        auto built = std::filesystem::last_write_time(output, ec);
+        bool stale = false;
+        for(auto& path : sources)
+            stale = stale || std::filesystem::last_write_time(path, ec) > built;
+
+        if(!stale)
+            return true;
+    }
+
+    return compile(source, output);
+}
+
+bool LevelCompiler::parse(const std::filesystem::path& source)
+{
+    std::error_code ec;
+    auto canonical = std::filesystem::weakly_canonical(source, ec);
+    for(auto& seen : m_sources)
+        if(seen == canonical)
+            return true;
+
+    m_sources.push_back(canonical);
+
+    std::ifstream in(source);
+    if(!in)
+    {
+        std::cerr << "[LevelCompiler] No se pudo abrir " << source << std::endl;
+        return false;
+    }
+
+    std::string line;
+    unsigned line_number = 0;
+    PrefabDef* current = nullptr;
+
+    auto error = [&](const std::string& message) {
+        std::cerr << "[LevelCompiler] " << source.string() << ":" << line_number << ": " << message << std::endl;
+        return false;
+    };
+
+    while(std::getline(in, line))
+    {
+        line_number++;
+
+        auto comment = line.find('#');
+        if(comment != std::string::npos)
+            line.resize(comment);
+
+        std::istringstream tokens(line);
+        std::vector<std::string> args;
+        for(std::string token; tokens >> token;)
+            args.push_back(std::move(token));
+
+        if(args.empty())
+            continue;
+
+        const std::string& cmd = args[0];
+
+        auto floats = [&](float* out, size_t count) {
+            if(args.size() != count + 1)
+                return false;
+            for(size_t i = 0; i < count; i++)
+                if(!parseFloat(args[i + 1], out[i]))
+                    return false;
+            return true;
+        };
+
+        if(!current)
+        {
+            if(cmd == "use")
+            {
+                if(args.size() != 2)
+                    return error("se esperaba 'use <fichero>'");
+
+                if(!parse(source.parent_path() / args[1]))
+                    return error("no se pudo usar " + args[1]);
+            }else if(cmd == "prefab")
+            {
+                if(args.size() != 2 && !(args.size() == 4 && args[2] == ":"))
+                    return error("se esperaba 'prefab <nombre> [: <base>]'");
+
+                if(m_prefab_names.count(args[1]))
+                    return error("prefab repetido: " + args[1]);
+
+                PrefabDef def;
+                def.record = defaultSettings();
+                if(args.size() == 4)
+                {
+                    auto base = m_prefab_names.find(args[3]);
+                    if(base == m_prefab_names.end())
+                        return error("prefab base desconocido: " + args[3]);
+                    def = m_prefabs[base->second];
+                }
+
+                def.name = args[1];
+                m_prefab_names.emplace(args[1], uint32_t(m_prefabs.size()));
+                m_prefabs.push_back(std::move(def));
+                current = &m_prefabs.back();
+            }else if(cmd == "place")
+            {
+                if(args.size() < 5)
+                    return error("se esperaba 'place <prefab> x y z [modificaciones]'");
+
+                auto prefab = m_prefab_names.find(args[1]);
+                if(prefab == m_prefab_names.end())
+                    return error("prefab desconocido: " + args[1]);
+
+                PlacementDef place;
+                place.prefab = prefab->second;
+                place.override = LevelFormat::NoIndex;
+                for(size_t i = 0; i < 3; i++)
+                    if(!parseFloat(args[2 + i], place.pos[i]))
+                        return error("posición inválida");
+
+                if(args.size() > 5)
+                {
+                    OverrideDef def{};
+                    auto& r = def.record;
+
+                    for(size_t i = 5; i < args.size(); i++)
+                    {
+                        auto eq = args[i].find('=');
+                        if(eq == std::string::npos || eq == 0)
+                            return error("modificación inválida: " + args[i]);
+
+                        std::string key = args[i].substr(0, eq);
+                        std::string value = args[i].substr(eq + 1);
+                        bool ok = true;
+
+                        if(key == "scale")
+                        {
+                            ok = parseVec3(value, r.scale);
+                            r.fields |= LevelFormat::OverrideScale;
+                        }else if(key == "axis" || key == "angle")
+                        {
+                            // La rotación se modifica entera: lo que no se da viene del prefab
+                            if(!(r.fields & LevelFormat::OverrideRotation))
+                            {
+                                const auto& base = m_prefabs[place.prefab].record;
+                                std::memcpy(r.axis, base.axis, sizeof(r.axis));
+                                r.angle = base.angle;
+                            }
+
+                            ok = key == "axis" ? parseVec3(value, r.axis) : parseFloat(value, r.angle);
+                            r.fields |= LevelFormat::OverrideRotation;
+                        }else
+                        {
+                            const auto& script = m_prefabs[place.prefab].script;
+                            if(script.empty() || script[0] == '@')
+                                return error("el prefab " + args[1] + " no tiene script con parámetros para " + key);
+
+                            ParamDef param{key, {}};
+                            ok = parseParam(value, param.value);
+                            def.params.push_back(std::move(param));
+                            r.fields |= LevelFormat::OverrideParams;
+                        }
+
+                        if(!ok)
+                            return error("valor inválido: " + args[i]);
+                    }
+
+                    place.override = uint32_t(m_overrides.size());
+                    m_overrides.push_back(std::move(def));
+                }
+
+                m_placements.push_back(place);
+            }else
+                return error("orden desconocida: " + cmd);
+
+            continue;
+        }
+
+        LevelFormat::Settings& r = current->record;
+        bool ok = true;
+
+        if(cmd == "end")
+            current = nullptr;
+        else if(cmd == "model" && args.size() == 2)
+            current->model = args[1] == "-" ? std::string() : args[1];
+        else if(cmd == "tag" && args.size() == 2)
+            current->tag = args[1];
+        else if(cmd == "box")
+            ok = floats(r.box_shape, 3);
+        else if(cmd == "rel_pos")
+            ok = floats(r.rel_pos, 3);
+        else if(cmd == "rel_scale")
+            ok = floats(r.rel_scale, 3);
+        else if(cmd == "rel_axis")
+            ok = floats(r.rel_axis, 3);
+        else if(cmd == "rel_angle")
+            ok = floats(&r.rel_angle, 1);
+        else if(cmd == "scale")
+            ok = floats(r.scale, 3);
+        else if(cmd == "axis")
+            ok = floats(r.axis, 3);
+        else if(cmd == "angle")
+            ok = floats(&r.angle, 1);
+        else if(cmd == "sensor" && args.size() == 1)
+            r.sensor = 1;
+        else if(cmd == "character" && args.size() == 1)
+            r.character = 1;
+        else if(cmd == "layer" && args.size() == 2)
+            current->layer = args[1];
+        else if(cmd == "on_start" && args.size() == 2)
+            current->on_start = args[1];
+        else if(cmd == "on_end" && args.size() == 2)
+            current->on_end = args[1];
+        else if(cmd == "body" && args.size() == 2)
+        {
+            if(args[1] == "static")
+                r.body_type = uint8_t(LevelFormat::BodyType::Static);
+            else if(args[1] == "dynamic")
+                r.body_type = uint8_t(LevelFormat::BodyType::Dynamic);
+            else if(args[1] == "kinematic")
+                r.body_type = uint8_t(LevelFormat::BodyType::Kinematic);
+            else
+                return error("tipo de cuerpo desconocido: " + args[1]);
+        }else if(cmd == "script" && args.size() >= 2)
+        {
+            current->script = args[1];
+            current->params.clear();
+
+            for(size_t i = 2; i < args.size(); i++)
+            {
+                auto eq = args[i].find('=');
+                if(eq == std::string::npos || eq == 0)
+                    return error("parámetro inválido: " + args[i]);
+
+                ParamDef param{args[i].substr(0, eq), {}};
+                if(!parseParam(args[i].substr(eq + 1), param.value))
+                    return error("valor inválido: " + args[i]);
+
+                current->params.push_back(std::move(param));
+            }
+
+            if(current->script[0] == '@' && !current->params.empty())
+                return error("los scripts del juego (@) no llevan parámetros");
+        }else
+            return error("orden desconocida o argumentos incorrectos: " + cmd);
+
+        if(!ok)
+            return error("números inválidos en " + cmd);
+    }
+
+    if(current)
+        return error("falta 'end'");
+
+    return true;
+}
+
+LevelFormat::String LevelCompiler::intern(const std::string& value)
+{
+    auto it = m_strings.find(value);
+    if(it != m_strings.end())
+        return it->second;
+
+    LevelFormat::String ref{uint32_t(m_chars.size()), uint32_t(value.size())};
+    m_chars += value;
+    m_strings.emplace(value, ref);
+    return ref;
+}
+
+bool LevelCompiler::write(const std::filesystem::path& output)
+{
+    std::vector<LevelFormat::Param> params;
+    std::vector<LevelFormat::Script> scripts;
+    std::vector<LevelFormat::Prefab> prefabs;
+    std::vector<LevelFormat::Override> overrides;
+
+    auto addParams = [&](const std::vector<ParamDef>& defs) {
+        for(auto& param : defs)
+        {
+            LevelFormat::Param value = param.value;
+            value.name = intern(param.name);
+            params.push_back(value);
+        }
+    };
+
+    prefabs.reserve(m_prefabs.size());
+    for(auto& def : m_prefabs)
+    {
+        LevelFormat::Prefab prefab{};
+        prefab.name = intern(def.name);
+        prefab.model = intern(def.model);
+        prefab.tag = intern(def.tag);
+        prefab.settings = def.record;
+        prefab.settings.layer = intern(def.layer);
+        prefab.settings.on_start = intern(def.on_start);
+        prefab.settings.on_end = intern(def.on_end);
+
+        if(!def.script.empty())
+        {
+            prefab.settings.script = uint32_t(scripts.size());
+            scripts.push_back({intern(def.script), uint32_t(params.size()), uint32_t(def.params.size())});
+            addParams(def.params);
+        }
+
+        prefabs.push_back(prefab);
+    }
+
+    overrides.reserve(m_overrides.size());
+    for(auto& def : m_overrides)
+    {
+        LevelFormat::Override record = def.record;
+        record.first_param = uint32_t(params.size());
+        record.param_count = uint32_t(def.params.size());
+        addParams(def.params);
+        overrides.push_back(record);
+    }
+
+    std::vector<LevelFormat::Placement> placements;
+    placements.reserve(m_placements.size());
+    for(auto& place : m_placements)
+        placements.push_back({place.prefab, place.override, {place.pos[0], place.pos[1], place.pos[2]}});
+
+    LevelFormat::Header header{};
+    std::memcpy(header.magic, LevelFormat::Magic, sizeof(header.magic));
+    header.version = LevelFormat::Version;
+
+    size_t offset = sizeof(header);
+    auto place = [&](LevelFormat::Section id, size_t count, size_t record) {
+        offset = (offset + 3) & ~size_t(3);
+        header.sections[size_t(id)] = {uint32_t(offset), uint32_t(count)};
+        offset += count * record;
+    };
+
+    place(LevelFormat::Section::Chars, m_chars.size(), 1);
+    place(LevelFormat::Section::Params, params.size(), sizeof(LevelFormat::Param));
+    place(LevelFormat::Section::Scripts, scripts.size(), sizeof(LevelFormat::Script));
+    place(LevelFormat::Section::Prefabs, prefabs.size(), sizeof(LevelFormat::Prefab));
+    place(LevelFormat::Section::Overrides, overrides.size(), sizeof(LevelFormat::Override));
+    place(LevelFormat::Section::Placements, placements.size(), sizeof(LevelFormat::Placement));
+
+    if(offset > UINT32_MAX)
+    {
+        std::cerr << "[LevelCompiler] Nivel demasiado grande" << std::endl;
+        return false;
+    }
+    header.size = uint32_t(offset);
+
+    std::vector<unsigned char> data(offset, 0);
+    auto copy = [&](LevelFormat::Section id, const void* src, size_t bytes) {
+        if(bytes)
+            std::memcpy(data.data() + header.sections[size_t(id)].offset, src, bytes);
+    };
+
+    std::memcpy(data.data(), &header, sizeof(header));
+    copy(LevelFormat::Section::Chars, m_chars.data(), m_chars.size());
+    copy(LevelFormat::Section::Params, params.data(), params.size() * sizeof(LevelFormat::Param));
+    copy(LevelFormat::Section::Scripts, scripts.data(), scripts.size() * sizeof(LevelFormat::Script));
+    copy(LevelFormat::Section::Prefabs, prefabs.data(), prefabs.size() * sizeof(LevelFormat::Prefab));
+    copy(LevelFormat::Section::Overrides, overrides.data(), overrides.size() * sizeof(LevelFormat::Override));
+    copy(LevelFormat::Section::Placements, placements.data(), placements.size() * sizeof(LevelFormat::Placement));
+
+    // Se escribe aparte y se renombra: quien tenga mapeado el fichero anterior no ve uno a medias
+    std::filesystem::path temp = output;
+    temp += ".tmp";
+
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if(!out.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size())))
+        {
+            std::cerr << "[LevelCompiler] No se pudo escribir " << temp << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp, output, ec);
+    if(ec)
+    {
+        std::cerr << "[LevelCompiler] No se pudo renombrar a " << output << ": " << ec.message() << std::endl;
+        return false;
+    }
+
+    return true;
+}
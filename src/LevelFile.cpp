@@ -0,0 +1,113 @@
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "LevelFile.hpp"
+
+
+namespace
+{
+    // Tamaño de registro de cada sección, en el orden de LevelFormat::Section
+    constexpr size_t RecordSize[LevelFormat::SectionCount] = {
+        1,
+        sizeof(LevelFormat::Param),
+        sizeof(LevelFormat::Script),
+        sizeof(LevelFormat::Prefab),
+        sizeof(LevelFormat::Override),
+        sizeof(LevelFormat::Placement),
+    };
+}
+
+LevelFile::~LevelFile()
+{
+    close();
+}
+
+bool LevelFile::open(const std::string& path)
+{
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        std::cerr << "[LevelFile] No se pudo abrir " << path << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || size_t(info.st_size) < sizeof(LevelFormat::Header))
+    {
+        std::cerr << "[LevelFile] Fichero demasiado pequeño: " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = size_t(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if(data == MAP_FAILED)
+    {
+        std::cerr << "[LevelFile] mmap falló: " << path << std::endl;
+        return false;
+    }
+
+    m_data = static_cast<const unsigned char*>(data);
+    m_size = size;
+
+    const auto& head = header();
+    if(std::memcmp(head.magic, LevelFormat::Magic, sizeof(head.magic)) != 0)
+    {
+        std::cerr << "[LevelFile] " << path << " no es un nivel binario" << std::endl;
+        close();
+        return false;
+    }
+
+    if(head.version != LevelFormat::Version || head.size != m_size)
+    {
+        std::cerr << "[LevelFile] " << path << " tiene versión " << head.version
+                  << " (se esperaba " << LevelFormat::Version << ") o está truncado" << std::endl;
+        close();
+        return false;
+    }
+
+    for(uint32_t i = 0; i < LevelFormat::SectionCount; i++)
+    {
+        const auto& ref = head.sections[i];
+        if(ref.offset % 4 != 0 || ref.offset > m_size || ref.count > (m_size - ref.offset) / RecordSize[i])
+        {
+            std::cerr << "[LevelFile] Sección " << i << " fuera del fichero en " << path << std::endl;
+            close();
+            return false;
+        }
+    }
+
+    // El kernel puede ir trayendo las páginas mientras se crean los objetos
+    madvise(const_cast<unsigned char*>(m_data), m_size, MADV_WILLNEED);
+    return true;
+}
+
+void LevelFile::close()
+{
+    if(m_data)
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+std::string_view LevelFile::str(const LevelFormat::String& ref) const
+{
+    if(!m_data)
+        return {};
+
+    const auto& chars = header().sections[size_t(LevelFormat::Section::Chars)];
+    if(ref.offset > chars.count || ref.length > chars.count - ref.offset)
+        return {};
+
+    return {reinterpret_cast<const char*>(m_data + chars.offset + ref.offset), ref.length};
+}
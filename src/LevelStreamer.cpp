@@ -0,0 +1,418 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <GLS/GameObject.hpp>
+#include <GLS/TransformComponent.hpp>
+#include <GLS/Utils.hpp>
+
+#include "BodyIDs.hpp"
+#include "LevelStreamer.hpp"
+
+
+LevelStreamer::LevelStreamer(std::shared_ptr<Engine::Scene> scene, const StreamingSettings& settings)
+    : m_scene(scene), m_settings(settings)
+{
+    if(m_settings.chunk_size <= 0.f)
+        m_settings.chunk_size = 32.f;
+
+    m_settings.unload_radius = std::max(m_settings.unload_radius, m_settings.load_radius);
+    m_settings.spawns_per_frame = std::max(1u, m_settings.spawns_per_frame);
+}
+
+bool LevelStreamer::open(const std::string& path, const LevelBindings& bindings)
+{
+    reset();
+    m_chunks.clear();
+    m_pools.clear();
+    m_pool_sizes.clear();
+    m_pooled_objects = 0;
+
+    if(!m_file.open(path) || !Level::resolve(m_file, bindings, m_prefabs))
+        return false;
+
+    auto placements = m_file.placements();
+    auto overrides = m_file.overrides();
+    for(uint32_t i = 0; i < placements.size(); i++)
+    {
+        const auto& place = placements[i];
+        if(place.prefab >= m_prefabs.size() || (place.override != LevelFormat::NoIndex && place.override >= overrides.size()))
+        {
+            std::cerr << "[LevelStreamer] Prefab u override fuera de rango en la colocación " << i << std::endl;
+            return false;
+        }
+
+        int x = cell(place.pos[0]);
+        int z = cell(place.pos[2]);
+
+        auto [it, inserted] = m_chunks.try_emplace(chunkKey(x, z));
+        if(inserted)
+        {
+            it->second.x = x;
+            it->second.z = z;
+        }
+        it->second.placements.push_back(i);
+
+        // Cada colocación está en un solo chunk: el pool nunca necesita más
+        m_pool_sizes[poolKey(place)]++;
+    }
+
+    return true;
+}
+
+int LevelStreamer::cell(float v) const
+{
+    return int(std::floor(v / m_settings.chunk_size));
+}
+
+uint64_t LevelStreamer::chunkKey(int x, int z)
+{
+    return (uint64_t(uint32_t(x)) << 32) | uint32_t(z);
+}
+
+uint64_t LevelStreamer::poolKey(const LevelFormat::Placement& place) const
+{
+    // La rotación se vuelve a aplicar al reutilizar; la escala y el script no
+    uint32_t variant = LevelFormat::NoIndex;
+    if(place.override != LevelFormat::NoIndex
+        && (m_file.overrides()[place.override].fields & (LevelFormat::OverrideScale | LevelFormat::OverrideParams)))
+        variant = place.override;
+
+    return (uint64_t(place.prefab) << 32) | variant;
+}
+
+float LevelStreamer::distance(const Chunk& chunk, const glm::vec3& player) const
+{
+    float size = m_settings.chunk_size;
+    float x0 = chunk.x * size;
+    float z0 = chunk.z * size;
+
+    float dx = std::max({x0 - player.x, 0.f, player.x - (x0 + size)});
+    float dz = std::max({z0 - player.z, 0.f, player.z - (z0 + size)});
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+void LevelStreamer::update(const glm::vec3& player)
+{
+    if(!m_file.isOpen())
+        return;
+
+    // Los radios sólo se vuelven a evaluar al cambiar de celda; la histéresis cubre el resto
+    int x = cell(player.x);
+    int z = cell(player.z);
+    if(!m_has_cell || x != m_cell_x || z != m_cell_z)
+    {
+        m_has_cell = true;
+        m_cell_x = x;
+        m_cell_z = z;
+        refresh(player);
+    }
+
+    load(m_settings.spawns_per_frame);
+}
+
+void LevelStreamer::warmup(const glm::vec3& player)
+{
+    if(!m_file.isOpen())
+        return;
+
+    m_has_cell = true;
+    m_cell_x = cell(player.x);
+    m_cell_z = cell(player.z);
+    refresh(player);
+
+    load(UINT32_MAX);
+}
+
+void LevelStreamer::reset()
+{
+    while(!m_resident.empty())
+        unload(*m_resident.back());
+
+    m_has_cell = false;
+}
+
+bool LevelStreamer::hide(JPH::BodyID id)
+{
+    auto placements = m_file.placements();
+
+    // Pocas llamadas (un impacto) sobre los objetos de los chunks cargados
+    for(Chunk* chunk : m_resident)
+    {
+        if(chunk->state != ChunkState::Active)
+            continue;
+
+        for(size_t i = 0; i < chunk->objects.size(); i++)
+        {
+            auto& obstacle = chunk->objects[i];
+            auto body = obstacle ? obstacle->getObject()->getBody() : nullptr;
+            if(!body || BodyIDs::Get().Find(body) != id)
+                continue;
+
+            pool(placements[chunk->placements[i]]).hide(obstacle);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void LevelStreamer::SaveState(JPH::StateRecorder& stream) const
+{
+    auto placements = m_file.placements();
+
+    uint32_t count = 0;
+    for(const Chunk* chunk : m_resident)
+        if(chunk->state == ChunkState::Active)
+            count++;
+
+    // Primero las claves: al restaurar hay que saber qué chunks sobran antes de leer objetos
+    stream.Write(count);
+    for(const Chunk* chunk : m_resident)
+    {
+        if(chunk->state != ChunkState::Active)
+            continue;
+
+        stream.Write(chunk->x);
+        stream.Write(chunk->z);
+    }
+
+    for(const Chunk* chunk : m_resident)
+    {
+        if(chunk->state != ChunkState::Active)
+            continue;
+
+        for(size_t i = 0; i < chunk->objects.size(); i++)
+        {
+            const auto& obstacle = chunk->objects[i];
+            stream.Write(obstacle != nullptr);
+            if(obstacle)
+                m_pools.at(poolKey(placements[chunk->placements[i]]))->saveState(obstacle, stream);
+        }
+    }
+}
+
+void LevelStreamer::RestoreState(JPH::StateRecorder& stream)
+{
+    auto placements = m_file.placements();
+
+    uint32_t count = 0;
+    stream.Read(count);
+
+    m_restoring.clear();
+    for(uint32_t i = 0; i < count; i++)
+    {
+        int x = 0, z = 0;
+        stream.Read(x);
+        stream.Read(z);
+
+        auto it = m_chunks.find(chunkKey(x, z));
+        if(it == m_chunks.end())
+        {
+            std::cerr << "[LevelStreamer] El snapshot es de otro nivel" << std::endl;
+            return;
+        }
+        m_restoring.push_back(&it->second);
+    }
+
+    // Fuera lo que no estaba activo al capturar; lo que estaba a medio cargar empieza de nuevo
+    for(size_t i = m_resident.size(); i-- > 0;)
+    {
+        Chunk* chunk = m_resident[i];
+        if(chunk->state != ChunkState::Active || std::find(m_restoring.begin(), m_restoring.end(), chunk) == m_restoring.end())
+            unload(*chunk);
+    }
+
+    for(Chunk* chunk : m_restoring)
+        if(chunk->state == ChunkState::Unloaded)
+            queue(*chunk);
+
+    load(UINT32_MAX);
+
+    for(Chunk* chunk : m_restoring)
+    {
+        for(size_t i = 0; i < chunk->placements.size(); i++)
+        {
+            bool present = false;
+            stream.Read(present);
+            if(!present)
+                continue;
+
+            const auto& obstacle = chunk->objects[i];
+            if(!obstacle)
+            {
+                std::cerr << "[LevelStreamer] No hay instancia para restaurar una colocación" << std::endl;
+                return;
+            }
+
+            pool(placements[chunk->placements[i]]).restoreState(obstacle, stream);
+        }
+    }
+
+    // El jugador también se ha restaurado: los radios se vuelven a evaluar en el siguiente update()
+    m_has_cell = false;
+}
+
+void LevelStreamer::refresh(const glm::vec3& player)
+{
+    for(size_t i = m_resident.size(); i-- > 0;)
+    {
+        if(distance(*m_resident[i], player) > m_settings.unload_radius)
+            unload(*m_resident[i]);
+    }
+
+    int x0 = cell(player.x - m_settings.load_radius);
+    int x1 = cell(player.x + m_settings.load_radius);
+    int z0 = cell(player.z - m_settings.load_radius);
+    int z1 = cell(player.z + m_settings.load_radius);
+
+    for(int x = x0; x <= x1; x++)
+    {
+        for(int z = z0; z <= z1; z++)
+        {
+            auto it = m_chunks.find(chunkKey(x, z));
+            if(it == m_chunks.end() || it->second.state != ChunkState::Unloaded)
+                continue;
+
+            if(distance(it->second, player) <= m_settings.load_radius)
+                queue(it->second);
+        }
+    }
+
+    // El más cercano al final, que es por donde se carga
+    std::sort(m_loading.begin(), m_loading.end(), [&](const Chunk* a, const Chunk* b) {
+        return distance(*a, player) > distance(*b, player);
+    });
+}
+
+void LevelStreamer::queue(Chunk& chunk)
+{
+    chunk.state = ChunkState::Loading;
+    chunk.objects.reserve(chunk.placements.size());
+    m_resident.push_back(&chunk);
+    m_loading.push_back(&chunk);
+}
+
+void LevelStreamer::load(unsigned budget)
+{
+    auto placements = m_file.placements();
+
+    while(budget > 0 && !m_loading.empty())
+    {
+        Chunk& chunk = *m_loading.back();
+
+        while(budget > 0 && chunk.objects.size() < chunk.placements.size())
+            chunk.objects.push_back(acquire(placements[chunk.placements[chunk.objects.size()]], budget));
+
+        if(chunk.objects.size() < chunk.placements.size())
+            return;
+
+        m_loading.pop_back();
+        activate(chunk);
+    }
+}
+
+void LevelStreamer::unload(Chunk& chunk)
+{
+    auto placements = m_file.placements();
+
+    size_t released = 0;
+    for(size_t i = 0; i < chunk.objects.size(); i++)
+    {
+        if(!chunk.objects[i])
+            continue;
+
+        pool(placements[chunk.placements[i]]).release(chunk.objects[i]);
+        released++;
+    }
+
+    if(chunk.state == ChunkState::Active)
+        m_active_objects -= released;
+
+    m_pooled_objects += released;
+    chunk.objects.clear();
+    chunk.state = ChunkState::Unloaded;
+
+    std::erase(m_resident, &chunk);
+    std::erase(m_loading, &chunk);
+}
+
+ObjectPool& LevelStreamer::pool(const LevelFormat::Placement& place)
+{
+    uint64_t key = poolKey(place);
+    auto& pool = m_pools[key];
+    if(pool)
+        return *pool;
+
+    // Nada prewarm: el streamer ya reparte la creación con spawns_per_frame
+    PoolSettings settings;
+    settings.prewarm = 0;
+    settings.max = m_pool_sizes[key];
+    settings.warn_on_grow = false;
+
+    // Sólo las variantes crean sus instancias con overrides; la rotación se aplica al colocar
+    PrefabOverrides overrides;
+    bool variant = uint32_t(key) != LevelFormat::NoIndex && Level::resolveOverrides(m_file, place, overrides);
+
+    pool = std::make_unique<ObjectPool>(m_scene, m_prefabs[place.prefab], settings, variant ? &overrides : nullptr);
+    return *pool;
+}
+
+std::shared_ptr<Obstacle> LevelStreamer::acquire(const LevelFormat::Placement& place, unsigned& budget)
+{
+    glm::vec3 pos(place.pos[0], place.pos[1], place.pos[2]);
+    const Prefab& prefab = *m_prefabs[place.prefab];
+
+    // Los scripts pueden haberlo movido o girado: vuelve a la colocación original
+    glm::quat rotation = Engine::Utils::toQuant(prefab.getSettings().axis, prefab.getSettings().angle);
+    if(place.override != LevelFormat::NoIndex)
+    {
+        const auto& r = m_file.overrides()[place.override];
+        if(r.fields & LevelFormat::OverrideRotation)
+            rotation = Engine::Utils::toQuant({r.axis[0], r.axis[1], r.axis[2]}, r.angle);
+    }
+
+    ObjectPool& objects = pool(place);
+    if(objects.getFree() == 0)
+    {
+        budget--;
+        m_created_objects++;
+    }else
+        m_pooled_objects--;
+
+    // Aparcado hasta que el chunk entero está listo
+    auto obstacle = objects.reserve(pos, rotation);
+    if(!obstacle)
+        std::cerr << "[LevelStreamer] No hay instancia para una colocación de " << prefab.getName() << std::endl;
+
+    return obstacle;
+}
+
+void LevelStreamer::activate(Chunk& chunk)
+{
+    auto placements = m_file.placements();
+
+    size_t shown = 0;
+    for(size_t i = 0; i < chunk.objects.size(); i++)
+    {
+        if(!chunk.objects[i])
+            continue;
+
+        pool(placements[chunk.placements[i]]).show(chunk.objects[i]);
+        shown++;
+    }
+
+    chunk.state = ChunkState::Active;
+    m_active_objects += shown;
+}
+
+LevelStreamerClock::LevelStreamerClock(std::shared_ptr<LevelStreamer> streamer)
+    : streamer(streamer)
+{
+}
+
+void LevelStreamerClock::OnUpdate(const GLfloat&)
+{
+    if(streamer)
+        streamer->update(getOwner()->getTransform()->getPosition());
+}
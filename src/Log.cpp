@@ -0,0 +1,217 @@
+#include <cctype>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "Log.hpp"
+
+
+namespace
+{
+    bool parseLevel(std::string name, LogLevel& level)
+    {
+        for(auto& c : name)
+            c = char(std::tolower(static_cast<unsigned char>(c)));
+
+        static const std::pair<const char*, LogLevel> names[] = {
+            {"trace", LogLevel::Trace}, {"debug", LogLevel::Debug}, {"info", LogLevel::Info},
+            {"warn", LogLevel::Warn}, {"error", LogLevel::Error}, {"off", LogLevel::Off}
+        };
+
+        for(auto& [key, value] : names)
+        {
+            if(name == key)
+            {
+                level = value;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+LogCategory::LogCategory(const char* name)
+    : m_name(name), m_level(int(LogLevel::Info))
+{
+    Log::Get().registerCategory(*this);
+}
+
+Log& Log::Get()
+{
+    static Log instance;
+    return instance;
+}
+
+Log::Log()
+    : m_cells(new Cell[Capacity]), m_out(&std::cout), m_start(Clock::now())
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "La capacidad debe ser potencia de dos");
+
+    for(size_t i = 0; i < Capacity; i++)
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+
+    m_running = true;
+    m_thread = std::thread(&Log::run, this);
+}
+
+Log::~Log()
+{
+    shutdown();
+}
+
+void Log::configure(const std::string& spec)
+{
+    std::stringstream stream(spec);
+    std::string entry;
+
+    while(std::getline(stream, entry, ','))
+    {
+        if(entry.empty())
+            continue;
+
+        LogLevel level;
+        size_t equals = entry.find('=');
+
+        if(equals == std::string::npos)
+        {
+            // Sin categoría: nivel por defecto para todas
+            if(!parseLevel(entry, level))
+            {
+                std::cerr << "[Log] Nivel desconocido: " << entry << std::endl;
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_default_level = level;
+            for(auto& [name, category] : m_categories)
+                if(!m_levels.count(name))
+                    category->setLevel(level);
+            continue;
+        }
+
+        if(!parseLevel(entry.substr(equals + 1), level))
+        {
+            std::cerr << "[Log] Nivel desconocido: " << entry << std::endl;
+            continue;
+        }
+
+        setLevel(entry.substr(0, equals), level);
+    }
+}
+
+void Log::setLevel(const std::string& category, LogLevel level)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_levels[category] = level;
+
+    auto it = m_categories.find(category);
+    if(it != m_categories.end())
+        it->second->setLevel(level);
+}
+
+void Log::setOutput(std::ostream* out)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_out = out ? out : &std::cout;
+}
+
+void Log::shutdown()
+{
+    if(!m_running.exchange(false))
+        return;
+
+    if(m_thread.joinable())
+        m_thread.join();
+
+    drain();
+}
+
+void Log::registerCategory(LogCategory& category)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_categories[category.getName()] = &category;
+
+    auto it = m_levels.find(category.getName());
+    category.setLevel(it != m_levels.end() ? it->second : m_default_level);
+}
+
+Log::Cell* Log::claim(uint64_t& pos)
+{
+    if(!m_running.load(std::memory_order_relaxed))
+        return nullptr;
+
+    // Cola acotada de varios productores: cada celda lleva una secuencia que dice
+    // si está libre para la vuelta actual del índice
+    pos = m_enqueue.load(std::memory_order_relaxed);
+    for(;;)
+    {
+        Cell* cell = &m_cells[pos & (Capacity - 1)];
+        uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+        int64_t diff = int64_t(sequence) - int64_t(pos);
+
+        if(diff == 0)
+        {
+            if(m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return cell;
+        }
+        else if(diff < 0)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        else
+        {
+            pos = m_enqueue.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Log::drain()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::ostream& out = *m_out;
+    bool wrote = false;
+
+    for(;;)
+    {
+        Cell& cell = m_cells[m_dequeue & (Capacity - 1)];
+        if(cell.sequence.load(std::memory_order_acquire) != m_dequeue + 1)
+            break;
+
+        const Record& record = cell.record;
+        float seconds = std::chrono::duration<float>(record.time - m_start).count();
+
+        out << std::fixed << std::setprecision(3) << seconds << std::defaultfloat
+            << " [" << record.category->getName() << "] ";
+
+        if(record.level == LogLevel::Warn)
+            out << "(aviso) ";
+        else if(record.level == LogLevel::Error)
+            out << "(error) ";
+
+        out << record.message;
+        record.format(out, record.args);
+        out << '\n';
+
+        cell.sequence.store(m_dequeue + Capacity, std::memory_order_release);
+        m_dequeue++;
+        wrote = true;
+    }
+
+    if(wrote)
+        out.flush();
+
+    return wrote;
+}
+
+void Log::run()
+{
+    while(m_running.load(std::memory_order_relaxed))
+    {
+        if(!drain())
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <iostream>
+
+#include <GLS/GameObject.hpp>
+#include <GLS/Physics.hpp>
+#include <GLS/TransformComponent.hpp>
+#include <GLS/Utils.hpp>
+
+#include "BodyIDs.hpp"
+#include "Log.hpp"
+#include "ObjectPool.hpp"
+#include "SceneSnapshot.hpp"
+
+
+namespace
+{
+    LogCategory log_pool("ObjectPool");
+}
+
+ObjectPool::ObjectPool(
+    std::shared_ptr<Engine::Scene> scene,
+    std::shared_ptr<const Prefab> prefab,
+    const PoolSettings& settings,
+    const PrefabOverrides* overrides)
+    : m_scene(std::move(scene)), m_prefab(std::move(prefab)), m_max(std::max(settings.prewarm, settings.max)),
+      m_warn_on_grow(settings.warn_on_grow), m_modified(overrides && overrides->fields)
+{
+    if(m_modified)
+        m_overrides = *overrides;
+
+    const ObstacleSettings& base = m_prefab->getSettings();
+    if(m_modified && (m_overrides.fields & PrefabOverrides::Rotation))
+        m_rotation = Engine::Utils::toQuant(m_overrides.axis, m_overrides.angle);
+    else
+        m_rotation = Engine::Utils::toQuant(base.axis, base.angle);
+
+    m_layer = CollisionLayers::Get().Register(base.layer.empty() ? m_prefab->getTag() : base.layer);
+
+    // Nada de lo que se toca en acquire()/release() debe reservar al crecer hasta m_max
+    m_slots.reserve(m_max);
+    m_free.reserve(m_max);
+    m_index.reserve(m_max);
+
+    for(size_t i = 0; i < settings.prewarm; i++)
+        grow();
+
+    m_grown = 0;
+}
+
+std::shared_ptr<Obstacle> ObjectPool::acquire(const glm::vec3& pos)
+{
+    return acquire(pos, m_rotation);
+}
+
+std::shared_ptr<Obstacle> ObjectPool::acquire(const glm::vec3& pos, const glm::quat& rotation)
+{
+    Slot* slot = take(pos, rotation);
+    if(!slot)
+        return nullptr;
+
+    unpark(*slot);
+    return slot->obstacle;
+}
+
+std::shared_ptr<Obstacle> ObjectPool::reserve(const glm::vec3& pos, const glm::quat& rotation)
+{
+    Slot* slot = take(pos, rotation);
+    return slot ? slot->obstacle : nullptr;
+}
+
+void ObjectPool::show(const std::shared_ptr<Obstacle>& obstacle)
+{
+    Slot* slot = find(obstacle);
+    if(slot && slot->state == SlotState::Reserved)
+        unpark(*slot);
+}
+
+void ObjectPool::hide(const std::shared_ptr<Obstacle>& obstacle)
+{
+    Slot* slot = find(obstacle);
+    if(!slot || slot->state != SlotState::Active)
+        return;
+
+    park(*slot);
+    slot->state = SlotState::Reserved;
+}
+
+void ObjectPool::release(const std::shared_ptr<Obstacle>& obstacle)
+{
+    Slot* slot = find(obstacle);
+    if(!slot || slot->state == SlotState::Free)
+        return;
+
+    park(*slot);
+    m_free.push_back(uint32_t(slot - m_slots.data()));
+}
+
+void ObjectPool::releaseAll()
+{
+    for(uint32_t i = 0; i < m_slots.size(); i++)
+    {
+        if(m_slots[i].state == SlotState::Free)
+            continue;
+
+        park(m_slots[i]);
+        m_free.push_back(i);
+    }
+}
+
+void ObjectPool::saveState(const std::shared_ptr<Obstacle>& obstacle, JPH::StateRecorder& stream) const
+{
+    const Slot* slot = find(obstacle);
+    if(!slot)
+        return;
+
+    stream.Write(slot->state == SlotState::Active);
+    SceneSnapshot::SaveObject(obstacle->getObject(), stream);
+
+    for(auto* state : slot->snapshotables)
+        state->SaveState(stream);
+}
+
+void ObjectPool::restoreState(const std::shared_ptr<Obstacle>& obstacle, JPH::StateRecorder& stream)
+{
+    Slot* slot = find(obstacle);
+    if(!slot || slot->state == SlotState::Free)
+        return;
+
+    bool shown = false;
+    stream.Read(shown);
+
+    // Aparcar y volver a mostrar reinicia la capa, la activación y los scripts Streamable
+    if(slot->state == SlotState::Active)
+    {
+        park(*slot);
+        slot->state = SlotState::Reserved;
+    }
+    if(shown)
+        unpark(*slot);
+
+    SceneSnapshot::RestoreObject(obstacle->getObject(), stream);
+
+    for(auto* state : slot->snapshotables)
+        state->RestoreState(stream);
+}
+
+bool ObjectPool::grow()
+{
+    if(m_slots.size() >= m_max)
+        return false;
+
+    Slot slot;
+    slot.obstacle = PrefabLibrary::Get().instantiate(m_scene, *m_prefab, {0.f, 0.f, 0.f}, m_modified ? &m_overrides : nullptr);
+
+    for(auto& component : slot.obstacle->getObject()->getComponents())
+    {
+        if(auto streamable = dynamic_cast<Streamable*>(component.get()))
+            slot.streamables.push_back(streamable);
+        if(auto state = dynamic_cast<Snapshotable*>(component.get()))
+            slot.snapshotables.push_back(state);
+    }
+
+    uint32_t index = uint32_t(m_slots.size());
+    m_index.emplace(slot.obstacle.get(), index);
+    m_slots.push_back(std::move(slot));
+
+    park(m_slots.back());
+    m_free.push_back(index);
+    m_grown++;
+    return true;
+}
+
+ObjectPool::Slot* ObjectPool::take(const glm::vec3& pos, const glm::quat& rotation)
+{
+    if(m_free.empty())
+    {
+        if(!grow())
+        {
+            m_exhausted++;
+            return nullptr;
+        }
+
+        if(m_warn_on_grow)
+            LOG_WARN(log_pool, "pool agotado, se crea otra instancia", m_slots.size());
+    }
+
+    Slot& slot = m_slots[m_free.back()];
+    m_free.pop_back();
+    slot.state = SlotState::Reserved;
+
+    auto object = slot.obstacle->getObject();
+    object->getTransform()->translate(pos);
+    object->getTransform()->rotate(rotation);
+
+    // Se mueve aparcado: todavía no colisiona con nada
+    auto body = object->getBody();
+    if(body && body->IsValid())
+    {
+        body->SetPosition(pos, JPH::EActivation::DontActivate);
+        body->SetRotation(rotation);
+    }
+
+    return &slot;
+}
+
+ObjectPool::Slot* ObjectPool::find(const std::shared_ptr<Obstacle>& obstacle)
+{
+    return const_cast<Slot*>(static_cast<const ObjectPool*>(this)->find(obstacle));
+}
+
+const ObjectPool::Slot* ObjectPool::find(const std::shared_ptr<Obstacle>& obstacle) const
+{
+    auto it = obstacle ? m_index.find(obstacle.get()) : m_index.end();
+    if(it == m_index.end())
+    {
+        std::cerr << "[ObjectPool] El objeto no pertenece al pool de " << m_prefab->getName() << std::endl;
+        return nullptr;
+    }
+
+    return &m_slots[it->second];
+}
+
+void ObjectPool::unpark(Slot& slot)
+{
+    slot.state = SlotState::Active;
+
+    auto object = slot.obstacle->getObject();
+    auto body = object->getBody();
+    if(body && body->IsValid())
+    {
+        // El cuerpo sigue en la broadphase: sólo recupera su capa
+        CollisionLayers::Get().Assign(body, m_layer);
+
+        if(body->getType() != Engine::BodyType::Static)
+        {
+            auto& bodies = Engine::Physics::Get().GetBodyInterface();
+            JPH::BodyID id = BodyIDs::Get().Find(body);
+            bodies.SetLinearAndAngularVelocity(id, JPH::Vec3::sZero(), JPH::Vec3::sZero());
+            bodies.ActivateBody(id);
+        }
+    }
+
+    object->setVisible(true);
+
+    for(auto* streamable : slot.streamables)
+        streamable->OnStreamIn();
+}
+
+void ObjectPool::park(Slot& slot)
+{
+    slot.state = SlotState::Free;
+
+    auto object = slot.obstacle->getObject();
+    object->setVisible(false);
+
+    for(auto* streamable : slot.streamables)
+        streamable->OnStreamOut();
+
+    auto body = object->getBody();
+    if(!body || !body->IsValid())
+        return;
+
+    // Sin quitarlo de la broadphase: dormido y en una capa que no colisiona con nada
+    CollisionLayers::Get().Assign(body, CollisionLayers::Parked);
+
+    if(body->getType() != Engine::BodyType::Static)
+    {
+        auto& bodies = Engine::Physics::Get().GetBodyInterface();
+        JPH::BodyID id = BodyIDs::Get().Find(body);
+        bodies.SetLinearAndAngularVelocity(id, JPH::Vec3::sZero(), JPH::Vec3::sZero());
+        bodies.DeactivateBody(id);
+    }
+}
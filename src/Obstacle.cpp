@@ -3,6 +3,10 @@
 
 #include "Obstacle.hpp"
 #include "Scripts.hpp"
+#include "CharacterController.hpp"
+#include "Triggers.hpp"
+#include "BodyIDs.hpp"
+#include "CollisionLayers.hpp"
 
 
 Obstacle::Obstacle(
@@ -27,7 +31,7 @@ Obstacle::Obstacle(
     const std::string& filename,
     const std::string& tag,
     const glm::vec3& pos,
-    ObstacleSettings settings
+    const ObstacleSettings& settings
 ): filename(filename), tag(tag)
 {
     m_index = scene->createGameObject();
@@ -40,23 +44,26 @@ Obstacle::Obstacle(
 
     
 
-    if(settings.rel_pos != glm::vec3(0.f, 0.f, 0.f))
+    // Sin modelo sólo queda el cuerpo (colisión invisible)
+    if(!filename.empty())
     {
         std::shared_ptr<Engine::ModelComponent>  m = scene->createModel(m_index);
         m->loadModel(filename);
-        m->setRelativeModel(
-            settings.rel_pos,
-            settings.rel_angle,
-            settings.rel_axis,
-            settings.rel_scale
-        );
-    }else
-        scene->createModel(m_index)->loadModel(filename);
+
+        if(settings.rel_pos != glm::vec3(0.f, 0.f, 0.f))
+            m->setRelativeModel(
+                settings.rel_pos,
+                settings.rel_angle,
+                settings.rel_axis,
+                settings.rel_scale
+            );
+    }
         
 
     if(settings.box_shape != JPH::Vec3::sZero())
     {
         m_object->setBody(Engine::Physics::Get().CreateBox(settings.box_shape, JPH::Vec3::sZero(), settings.body_type));
+        BodyIDs::Get().Track(m_object->getBody());
     }
 
     initCollitions(settings, m_scene);
@@ -67,7 +74,7 @@ Obstacle::Obstacle(
     unsigned index_ref,
     const std::string& tag,
     const glm::vec3& pos,
-    ObstacleSettings settings
+    const ObstacleSettings& settings
 ): tag(tag)
 
 {
@@ -83,6 +90,8 @@ Obstacle::Obstacle(
 
     if(body)
     {
+        // El clon tiene un cuerpo nuevo de Jolt
+        BodyIDs::Get().Track(body);
         body->SetPosition({pos.x, pos.y, pos.z});
     }
 
@@ -91,36 +100,40 @@ Obstacle::Obstacle(
 }
 
 
+const std::shared_ptr<Engine::GameObject>& Obstacle::getObject() const
+{
+    return m_object;
+}
+
+
 void Obstacle::initCollitions(const ObstacleSettings& settings, const std::shared_ptr<Engine::Scene>& scene)
 {
     if( m_object->getBody() == nullptr)
         return;
 
+    CollisionLayers::Get().Assign(m_object->getBody(), settings.layer.empty() ? tag : settings.layer);
 
-    if(settings.script == "PlataformaMovil")
-    {
-        if(settings.script_params.size() != 3)
-            m_object->addScript(std::make_shared<PlataformaMovil>());
-        else
-            m_object->addScript(std::make_shared<PlataformaMovil>(settings.script_params));
-    }
 
-    if(settings.script == "Enemy")
+    if(settings.script.valid())
+        m_object->addScript(settings.script.create());
+
+
+    if(settings.sensor)
     {
-        if(settings.script_params.size() != 3)
-            m_object->addScript(std::make_shared<Enemy>());
-        else
-            m_object->addScript(std::make_shared<Enemy>(settings.script_params));
+        Triggers::Get().Add(m_object->getBody(), settings.onContactStart, settings.onContactEnd);
+        return;
     }
 
-    if(settings.script == "Parachute")
+    if(settings.character)
     {
-        if(settings.script_params.size() != 3)
-            exit(1);
-        else
-            m_object->addScript(std::make_shared<Parachute>(settings.script_params));
-    }
+        if(settings.onContactStart)
+            settings.character->Add(Engine::Listener::Event::ContactAdded, m_object, settings.onContactStart);
 
+        if(settings.onContactEnd)
+            settings.character->Add(Engine::Listener::Event::ContactRemoved, m_object, settings.onContactEnd);
+
+        return;
+    }
 
     if(settings.onContactStart)
     {
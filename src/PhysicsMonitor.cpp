@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <iostream>
+
+#include <GLS/Physics.hpp>
+
+#include <Jolt/Physics/Body/Body.h>
+
+#include "PhysicsMonitor.hpp"
+#include "PhysicsSetup.hpp"
+
+
+PhysicsMonitor::PhysicsMonitor(float report_interval)
+    : m_report_interval(report_interval), m_links(std::make_unique<Link[]>(MaxLinks))
+{
+    auto& system = Engine::Physics::Get().GetSystem();
+
+    m_next = system.GetContactListener();
+    system.SetContactListener(this);
+    system.AddStepListener(this);
+}
+
+PhysicsMonitor::~PhysicsMonitor()
+{
+    if(!Engine::Physics::IsInitialized())
+        return;
+
+    auto& system = Engine::Physics::Get().GetSystem();
+
+    if(system.GetContactListener() == this)
+        system.SetContactListener(m_next);
+    system.RemoveStepListener(this);
+}
+
+void PhysicsMonitor::reset()
+{
+    m_peak = {};
+}
+
+void PhysicsMonitor::print(std::ostream& out) const
+{
+    auto percent = [](size_t value, size_t max) {
+        return max == 0 ? 0.f : 100.f * float(value) / float(max);
+    };
+
+    out << "[Physics] paso hasta scripts " << m_last.step_to_update << " ms (pico " << m_peak.step_to_update << " ms)"
+        << " | pares validados " << m_peak.validated_pairs
+        << " | callbacks de contacto " << m_peak.contact_callbacks;
+
+    // Cada callback es un manifold; sólo aproxima las restricciones de contacto del límite
+    if(const PhysicsBudget* budget = PhysicsSetup::Get().getBudget())
+        out << " (~" << percent(m_peak.contact_callbacks, budget->max_contact_constraints)
+            << "% de " << budget->max_contact_constraints << " restricciones)";
+
+    out << " | islas " << m_last.islands
+        << " | cuerpos " << m_last.active_bodies << "/" << m_last.bodies << "/" << m_last.max_bodies
+        << std::endl;
+}
+
+JPH::ValidateResult PhysicsMonitor::OnContactValidate(
+    const JPH::Body& inBody1,
+    const JPH::Body& inBody2,
+    JPH::RVec3Arg inBaseOffset,
+    const JPH::CollideShapeResult& inCollisionResult)
+{
+    m_pairs.fetch_add(1, std::memory_order_relaxed);
+
+    if(m_next)
+        return m_next->OnContactValidate(inBody1, inBody2, inBaseOffset, inCollisionResult);
+
+    return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
+}
+
+void PhysicsMonitor::OnContactAdded(
+    const JPH::Body& inBody1,
+    const JPH::Body& inBody2,
+    const JPH::ContactManifold& inManifold,
+    JPH::ContactSettings& ioSettings)
+{
+    m_contacts.fetch_add(1, std::memory_order_relaxed);
+    track(inBody1, inBody2);
+
+    if(m_next)
+        m_next->OnContactAdded(inBody1, inBody2, inManifold, ioSettings);
+}
+
+void PhysicsMonitor::OnContactPersisted(
+    const JPH::Body& inBody1,
+    const JPH::Body& inBody2,
+    const JPH::ContactManifold& inManifold,
+    JPH::ContactSettings& ioSettings)
+{
+    m_contacts.fetch_add(1, std::memory_order_relaxed);
+    track(inBody1, inBody2);
+
+    if(m_next)
+        m_next->OnContactPersisted(inBody1, inBody2, inManifold, ioSettings);
+}
+
+void PhysicsMonitor::OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair)
+{
+    if(m_next)
+        m_next->OnContactRemoved(inSubShapePair);
+}
+
+void PhysicsMonitor::OnStep(const JPH::PhysicsStepListenerContext& inContext)
+{
+    if(!inContext.mIsFirstStep)
+        return;
+
+    m_step_start = Clock::now();
+    m_stepped.store(true, std::memory_order_release);
+}
+
+void PhysicsMonitor::OnUpdate(const GLfloat& dt)
+{
+    collect();
+
+    if(m_report_interval <= 0.f)
+        return;
+
+    m_report_timer += dt;
+    if(m_report_timer >= m_report_interval)
+    {
+        m_report_timer = 0.f;
+        print(std::cout);
+    }
+}
+
+void PhysicsMonitor::track(const JPH::Body& body1, const JPH::Body& body2)
+{
+    // Sólo los cuerpos dinámicos unen islas, los estáticos y cinemáticos las separan
+    if(!body1.IsDynamic() || !body2.IsDynamic())
+        return;
+
+    unsigned index = m_link_count.fetch_add(1, std::memory_order_relaxed);
+    if(index < MaxLinks)
+        m_links[index] = {body1.GetID().GetIndex(), body2.GetID().GetIndex()};
+}
+
+void PhysicsMonitor::collect()
+{
+    if(!m_stepped.exchange(false, std::memory_order_acquire))
+        return;
+
+    auto& system = Engine::Physics::Get().GetSystem();
+
+    PhysicsStats stats;
+    stats.step_to_update = std::chrono::duration<float, std::milli>(Clock::now() - m_step_start).count();
+    stats.validated_pairs = m_pairs.exchange(0, std::memory_order_relaxed);
+    stats.contact_callbacks = m_contacts.exchange(0, std::memory_order_relaxed);
+    stats.bodies = system.GetNumBodies();
+    stats.max_bodies = system.GetMaxBodies();
+    stats.active_bodies = system.GetNumActiveBodies(JPH::EBodyType::RigidBody);
+
+    // Recorre todos los cuerpos; los cinemáticos activos no están en ninguna isla
+    unsigned active_dynamic = system.GetBodyStats().mNumActiveBodiesDynamic;
+    stats.islands = active_dynamic - std::min(active_dynamic, countMerges());
+
+    m_last = stats;
+
+    m_peak.step_to_update = std::max(m_peak.step_to_update, stats.step_to_update);
+    m_peak.validated_pairs = std::max(m_peak.validated_pairs, stats.validated_pairs);
+    m_peak.contact_callbacks = std::max(m_peak.contact_callbacks, stats.contact_callbacks);
+    m_peak.islands = std::max(m_peak.islands, stats.islands);
+    m_peak.bodies = std::max(m_peak.bodies, stats.bodies);
+    m_peak.active_bodies = std::max(m_peak.active_bodies, stats.active_bodies);
+    m_peak.max_bodies = stats.max_bodies;
+}
+
+unsigned PhysicsMonitor::countMerges()
+{
+    unsigned count = std::min(m_link_count.exchange(0, std::memory_order_relaxed), MaxLinks);
+    m_parents.clear();
+
+    auto find = [this](uint32_t id) {
+        auto it = m_parents.emplace(id, id).first;
+        while(it->second != it->first)
+        {
+            auto parent = m_parents.find(it->second);
+            it->second = parent->second;
+            it = parent;
+        }
+        return it->first;
+    };
+
+    unsigned merges = 0;
+    for(unsigned i = 0; i < count; i++)
+    {
+        auto [id1, id2] = m_links[i];
+        uint32_t root1 = find(id1);
+        uint32_t root2 = find(id2);
+        if(root1 != root2)
+        {
+            m_parents[root1] = root2;
+            ++merges;
+        }
+    }
+
+    return merges;
+}
@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <thread>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
+#include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
+#include <Jolt/Physics/Collision/NarrowPhaseQuery.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+
+#include <GLS/Physics.hpp>
+
+#include "Log.hpp"
+#include "PhysicsQueries.hpp"
+
+
+namespace
+{
+    LogCategory log_queries("PhysicsQueries");
+
+    JPH::Vec3 toJolt(const glm::vec3& v)
+    {
+        return {v.x, v.y, v.z};
+    }
+
+    glm::vec3 toGlm(JPH::Vec3Arg v)
+    {
+        return {v.GetX(), v.GetY(), v.GetZ()};
+    }
+
+    // Cuerpos distintos que solapan, hasta OverlapResult::MaxBodies
+    class OverlapCollector : public JPH::CollideShapeCollector
+    {
+        public:
+        explicit OverlapCollector(OverlapResult& result) : m_result(result) {}
+
+        void AddHit(const JPH::CollideShapeResult& inResult) override
+        {
+            for(uint32_t i = 0; i < m_result.count; i++)
+                if(m_result.bodies[i] == inResult.mBodyID2)
+                    return;
+
+            if(m_result.count == OverlapResult::MaxBodies)
+            {
+                m_result.truncated = true;
+                ForceEarlyOut();
+                return;
+            }
+
+            m_result.bodies[m_result.count++] = inResult.mBodyID2;
+        }
+
+        private:
+        OverlapResult& m_result;
+    };
+
+    bool fits(size_t queries, size_t results, const char* what)
+    {
+        if(results >= queries)
+            return true;
+
+        LOG_WARN(log_queries, "sin sitio para los resultados (llamada, consultas, resultados):", what, queries, results);
+        return false;
+    }
+}
+
+PhysicsQueries& PhysicsQueries::Get()
+{
+    static PhysicsQueries instance;
+    return instance;
+}
+
+void PhysicsQueries::setMaxThreads(int threads)
+{
+    threads = std::max(threads, 0);
+    if(threads == m_max_threads)
+        return;
+
+    // Se vuelve a crear con la siguiente consulta que lo necesite
+    m_max_threads = threads;
+    m_jobs.reset();
+}
+
+JPH::JobSystem& PhysicsQueries::getJobSystem()
+{
+    // Como mucho los núcleos que deja libres el hilo de juego
+    if(!m_jobs)
+    {
+        int cores = int(std::thread::hardware_concurrency()) - 1;
+        int threads = std::min(m_max_threads, std::max(cores, 0));
+        m_jobs = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, threads);
+    }
+
+    return *m_jobs;
+}
+
+PhysicsQueries::Filter::Filter(CollisionLayers::Layer layer, JPH::BodyID ignore, bool sensors)
+    : CollisionLayers::BodyFilter(CollisionLayers::Get(), layer, ignore), m_sensors(sensors)
+{
+}
+
+bool PhysicsQueries::Filter::ShouldCollideLocked(const JPH::Body& inBody) const
+{
+    if(!m_sensors && inBody.IsSensor())
+        return false;
+
+    return CollisionLayers::BodyFilter::ShouldCollideLocked(inBody);
+}
+
+bool PhysicsQueries::castRays(std::span<const RayQuery> queries, std::span<QueryHit> results)
+{
+    if(!fits(queries.size(), results.size(), "castRays"))
+        return false;
+
+    parallelFor(uint32_t(queries.size()), BatchSize, [&](uint32_t begin, uint32_t end) {
+        castRays(queries, results, begin, end);
+    });
+    return true;
+}
+
+bool PhysicsQueries::castSpheres(std::span<const SphereCastQuery> queries, std::span<QueryHit> results)
+{
+    if(!fits(queries.size(), results.size(), "castSpheres"))
+        return false;
+
+    parallelFor(uint32_t(queries.size()), BatchSize, [&](uint32_t begin, uint32_t end) {
+        castSpheres(queries, results, begin, end);
+    });
+    return true;
+}
+
+bool PhysicsQueries::overlapSpheres(std::span<const OverlapQuery> queries, std::span<OverlapResult> results)
+{
+    if(!fits(queries.size(), results.size(), "overlapSpheres"))
+        return false;
+
+    parallelFor(uint32_t(queries.size()), BatchSize, [&](uint32_t begin, uint32_t end) {
+        overlapSpheres(queries, results, begin, end);
+    });
+    return true;
+}
+
+void PhysicsQueries::castRays(std::span<const RayQuery> queries, std::span<QueryHit> results, uint32_t begin, uint32_t end)
+{
+    auto& system = Engine::Physics::Get().GetSystem();
+    const auto& query = system.GetNarrowPhaseQuery();
+
+    for(uint32_t i = begin; i < end; i++)
+    {
+        const RayQuery& q = queries[i];
+        QueryHit& result = results[i];
+        result = QueryHit();
+
+        JPH::RRayCast ray{JPH::RVec3(toJolt(q.origin)), toJolt(q.direction)};
+        JPH::RayCastResult hit;
+        Filter filter(q.layer, q.ignore, q.sensors);
+        auto broadphase_filter = CollisionLayers::Get().MakeBroadPhaseFilter(q.layer);
+        auto layer_filter = CollisionLayers::Get().MakeObjectLayerFilter(q.layer);
+
+        if(!query.CastRay(ray, hit, broadphase_filter, layer_filter, filter))
+            continue;
+
+        JPH::RVec3 point = ray.GetPointOnRay(hit.mFraction);
+        JPH::Vec3 normal = -ray.mDirection.NormalizedOr(JPH::Vec3::sAxisY());
+
+        JPH::BodyLockRead lock(system.GetBodyLockInterface(), hit.mBodyID);
+        if(lock.Succeeded())
+            normal = lock.GetBody().GetWorldSpaceSurfaceNormal(hit.mSubShapeID2, point);
+
+        result.body = hit.mBodyID;
+        result.fraction = hit.mFraction;
+        result.point = toGlm(JPH::Vec3(point));
+        result.normal = toGlm(normal);
+    }
+}
+
+void PhysicsQueries::castSpheres(std::span<const SphereCastQuery> queries, std::span<QueryHit> results, uint32_t begin, uint32_t end)
+{
+    const auto& query = Engine::Physics::Get().GetSystem().GetNarrowPhaseQuery();
+
+    JPH::ShapeCastSettings settings;
+    settings.mReturnDeepestPoint = true;
+
+    for(uint32_t i = begin; i < end; i++)
+    {
+        const SphereCastQuery& q = queries[i];
+        QueryHit& result = results[i];
+        result = QueryHit();
+
+        // En la pila: Jolt no la libera al soltar la referencia
+        JPH::SphereShape sphere(q.radius);
+        sphere.SetEmbedded();
+
+        JPH::RShapeCast cast = JPH::RShapeCast::sFromWorldTransform(
+            &sphere, JPH::Vec3::sReplicate(1.f), JPH::RMat44::sTranslation(JPH::RVec3(toJolt(q.origin))), toJolt(q.direction));
+
+        JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> collector;
+        Filter filter(q.layer, q.ignore, q.sensors);
+        auto broadphase_filter = CollisionLayers::Get().MakeBroadPhaseFilter(q.layer);
+        auto layer_filter = CollisionLayers::Get().MakeObjectLayerFilter(q.layer);
+        query.CastShape(cast, settings, JPH::RVec3::sZero(), collector, broadphase_filter, layer_filter, filter);
+
+        if(!collector.HadHit())
+            continue;
+
+        const auto& hit = collector.mHit;
+        result.body = hit.mBodyID2;
+        result.fraction = hit.mFraction;
+        result.point = toGlm(hit.mContactPointOn2);
+        result.normal = toGlm(-hit.mPenetrationAxis.NormalizedOr(JPH::Vec3::sAxisY()));
+    }
+}
+
+void PhysicsQueries::overlapSpheres(std::span<const OverlapQuery> queries, std::span<OverlapResult> results, uint32_t begin, uint32_t end)
+{
+    const auto& query = Engine::Physics::Get().GetSystem().GetNarrowPhaseQuery();
+    JPH::CollideShapeSettings settings;
+
+    for(uint32_t i = begin; i < end; i++)
+    {
+        const OverlapQuery& q = queries[i];
+        OverlapResult& result = results[i];
+        result = OverlapResult();
+
+        JPH::SphereShape sphere(q.radius);
+        sphere.SetEmbedded();
+
+        OverlapCollector collector(result);
+        Filter filter(q.layer, q.ignore, q.sensors);
+        auto broadphase_filter = CollisionLayers::Get().MakeBroadPhaseFilter(q.layer);
+        auto layer_filter = CollisionLayers::Get().MakeObjectLayerFilter(q.layer);
+        query.CollideShape(
+            &sphere, JPH::Vec3::sReplicate(1.f), JPH::RMat44::sTranslation(JPH::RVec3(toJolt(q.center))),
+            settings, JPH::RVec3::sZero(), collector, broadphase_filter, layer_filter, filter);
+    }
+}
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <memory>
+
+#include <GLS/Physics.hpp>
+
+#include "CollisionLayers.hpp"
+#include "PhysicsSetup.hpp"
+
+
+PhysicsSetup& PhysicsSetup::Get()
+{
+    static PhysicsSetup instance;
+    return instance;
+}
+
+bool PhysicsSetup::Apply(const PhysicsBudget& budget)
+{
+    if(!Engine::Physics::IsInitialized())
+    {
+        std::cerr << "[PhysicsSetup] Physics::Init() todavía no se ha llamado" << std::endl;
+        return false;
+    }
+
+    auto& system = Engine::Physics::Get().GetSystem();
+    if(system.GetNumBodies() != 0)
+    {
+        std::cerr << "[PhysicsSetup] Ya hay cuerpos, se mantienen los límites del motor" << std::endl;
+        return false;
+    }
+
+    // Lo que el motor dejó configurado y debe sobrevivir a la reconstrucción
+    JPH::PhysicsSettings settings = system.GetPhysicsSettings();
+    JPH::Vec3 gravity = system.GetGravity();
+    JPH::ContactListener* contacts = system.GetContactListener();
+    JPH::BodyActivationListener* activation = system.GetBodyActivationListener();
+    auto combine_friction = system.GetCombineFriction();
+    auto combine_restitution = system.GetCombineRestitution();
+
+    // PhysicsSystem::Init() sólo se puede llamar una vez: se destruye y se vuelve
+    // a construir en la misma dirección, que es la que guarda el motor
+    std::destroy_at(&system);
+    std::construct_at(&system);
+
+    auto& layers = CollisionLayers::Get();
+    system.Init(
+        budget.max_bodies,
+        budget.num_body_mutexes,
+        budget.max_body_pairs,
+        budget.max_contact_constraints,
+        layers.GetBroadPhaseLayerInterface(),
+        layers.GetObjectVsBroadPhaseFilter(),
+        layers.GetObjectLayerPairFilter()
+    );
+    system.SetPhysicsSettings(settings);
+    system.SetGravity(gravity);
+    system.SetContactListener(contacts);
+    system.SetBodyActivationListener(activation);
+    system.SetCombineFriction(combine_friction);
+    system.SetCombineRestitution(combine_restitution);
+
+    m_budget = budget;
+    m_applied = true;
+    return true;
+}
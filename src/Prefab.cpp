@@ -0,0 +1,126 @@
+#include <iostream>
+
+#include <GLS/GameObject.hpp>
+#include <GLS/Physics.hpp>
+
+#include "BodyIDs.hpp"
+#include "Prefab.hpp"
+
+
+Prefab::Prefab(std::string name, std::string model, std::string tag, ObstacleSettings settings)
+    : m_name(std::move(name)), m_model(std::move(model)), m_tag(std::move(tag)), m_settings(std::move(settings))
+{
+}
+
+
+PrefabLibrary& PrefabLibrary::Get()
+{
+    static PrefabLibrary instance;
+    return instance;
+}
+
+std::shared_ptr<const Prefab> PrefabLibrary::add(std::shared_ptr<const Prefab> prefab)
+{
+    if(!prefab)
+        return nullptr;
+
+    auto [it, inserted] = m_prefabs.emplace(prefab->getName(), prefab);
+    return it->second;
+}
+
+std::shared_ptr<const Prefab> PrefabLibrary::find(const std::string& name) const
+{
+    auto it = m_prefabs.find(name);
+    return it != m_prefabs.end() ? it->second : nullptr;
+}
+
+void PrefabLibrary::releaseScene(const Engine::Scene* scene)
+{
+    for(auto it = m_templates.begin(); it != m_templates.end();)
+    {
+        if(it->first.first == scene)
+            it = m_templates.erase(it);
+        else
+            ++it;
+    }
+}
+
+unsigned PrefabLibrary::getTemplate(const std::shared_ptr<Engine::Scene>& scene, const Prefab& prefab)
+{
+    auto key = std::make_pair(static_cast<const Engine::Scene*>(scene.get()), &prefab);
+    auto it = m_templates.find(key);
+    if(it != m_templates.end())
+        return it->second;
+
+    // La plantilla sólo aporta modelo y cuerpo: nada de scripts, triggers ni listeners
+    ObstacleSettings settings = prefab.getSettings();
+    settings.script = {};
+    settings.onContactStart = nullptr;
+    settings.onContactEnd = nullptr;
+    settings.character = nullptr;
+    settings.sensor = false;
+
+    Obstacle obstacle(scene, prefab.getModel(), prefab.getTag(), {0.f, 0.f, 0.f}, settings);
+
+    auto object = obstacle.getObject();
+    object->setVisible(false);
+
+    auto body = object->getBody();
+    if(body && body->IsValid())
+    {
+        auto& bodies = Engine::Physics::Get().GetBodyInterface();
+        JPH::BodyID id = BodyIDs::Get().Find(body);
+        if(bodies.IsAdded(id))
+            bodies.RemoveBody(id);
+    }
+
+    m_templates.emplace(key, obstacle.getIndex());
+    return obstacle.getIndex();
+}
+
+std::shared_ptr<Obstacle> PrefabLibrary::instantiate(
+    const std::shared_ptr<Engine::Scene>& scene,
+    const Prefab& prefab,
+    const glm::vec3& pos,
+    const PrefabOverrides* overrides)
+{
+    unsigned index = getTemplate(scene, prefab);
+
+    std::shared_ptr<Obstacle> obstacle;
+    if(overrides && overrides->fields)
+    {
+        ObstacleSettings settings = prefab.getSettings();
+        if(overrides->fields & PrefabOverrides::Scale)
+            settings.scale = overrides->scale;
+
+        if(overrides->fields & PrefabOverrides::Rotation)
+        {
+            settings.axis = overrides->axis;
+            settings.angle = overrides->angle;
+        }
+
+        if(overrides->fields & PrefabOverrides::Script)
+            settings.script = overrides->script;
+
+        obstacle = std::make_shared<Obstacle>(scene, index, prefab.getTag(), pos, settings);
+    }else
+        obstacle = std::make_shared<Obstacle>(scene, index, prefab.getTag(), pos, prefab.getSettings());
+
+    // El clon hereda el estado de la plantilla (oculta y sin cuerpo en la simulación)
+    auto object = obstacle->getObject();
+    object->setVisible(true);
+
+    auto body = object->getBody();
+    if(body && body->IsValid())
+    {
+        auto& bodies = Engine::Physics::Get().GetBodyInterface();
+        JPH::BodyID id = BodyIDs::Get().Find(body);
+        if(!bodies.IsAdded(id))
+        {
+            bool still = body->getType() == Engine::BodyType::Static;
+            bodies.AddBody(id, still ? JPH::EActivation::DontActivate : JPH::EActivation::Activate);
+        }
+    }
+
+    return obstacle;
+}
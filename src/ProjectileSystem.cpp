@@ -0,0 +1,297 @@
+#include <algorithm>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Math/Float4.h>
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/NarrowPhaseQuery.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+
+#include <GLS/GameObject.hpp>
+#include <GLS/Physics.hpp>
+#include <GLS/TransformComponent.hpp>
+
+#include "Coroutine.hpp"
+#include "ObjectPool.hpp"
+#include "PhysicsQueries.hpp"
+#include "ProjectileSystem.hpp"
+
+
+namespace
+{
+    constexpr size_t Lanes = 4;
+
+    JPH::Vec4 load(const std::vector<float>& values, size_t i)
+    {
+        return JPH::Vec4::sLoadFloat4(reinterpret_cast<const JPH::Float4*>(&values[i]));
+    }
+
+    void store(JPH::Vec4Arg value, std::vector<float>& values, size_t i)
+    {
+        value.StoreFloat4(reinterpret_cast<JPH::Float4*>(&values[i]));
+    }
+
+    size_t roundLanes(size_t count)
+    {
+        return (count + Lanes - 1) & ~(Lanes - 1);
+    }
+
+    glm::vec3 toGlm(JPH::Vec3Arg v)
+    {
+        return {v.GetX(), v.GetY(), v.GetZ()};
+    }
+}
+
+ProjectileSystem::ProjectileSystem(const ProjectileSettings& settings)
+    : m_settings(settings)
+{
+    m_settings.batch_size = std::max<size_t>(m_settings.batch_size, 1);
+    m_layer = CollisionLayers::Get().Register(m_settings.layer);
+
+    size_t lanes = roundLanes(m_settings.capacity);
+    for(auto* values : {&m_px, &m_py, &m_pz, &m_vx, &m_vy, &m_vz, &m_dx, &m_dy, &m_dz, &m_life})
+        values->resize(lanes, 0.f);
+
+    m_owner.resize(lanes);
+    m_hit_body.resize(lanes);
+    m_hit_point.resize(lanes);
+    m_hit_normal.resize(lanes);
+
+    m_events.reserve(m_settings.capacity);
+    m_dispatching.reserve(m_settings.capacity);
+}
+
+bool ProjectileSystem::spawn(const glm::vec3& pos, const glm::vec3& velocity, JPH::BodyID owner)
+{
+    if(m_count == m_settings.capacity)
+    {
+        m_dropped++;
+        return false;
+    }
+
+    size_t i = m_count++;
+    m_px[i] = pos.x;
+    m_py[i] = pos.y;
+    m_pz[i] = pos.z;
+    m_vx[i] = velocity.x;
+    m_vy[i] = velocity.y;
+    m_vz[i] = velocity.z;
+    m_life[i] = m_settings.lifetime;
+    m_owner[i] = owner;
+    return true;
+}
+
+void ProjectileSystem::clear()
+{
+    m_count = 0;
+    m_events.clear();
+}
+
+void ProjectileSystem::setOnHit(HitCallback callback)
+{
+    m_on_hit = std::move(callback);
+}
+
+void ProjectileSystem::update(float dt)
+{
+    if(m_count == 0 || dt <= 0.f)
+        return;
+
+    integrate(dt);
+    castRays();
+    advance();
+    retire();
+    dispatch();
+}
+
+void ProjectileSystem::integrate(float dt)
+{
+    JPH::Vec3 gravity = Engine::Physics::Get().GetSystem().GetGravity() * m_settings.gravity_scale;
+
+    JPH::Vec4 step = JPH::Vec4::sReplicate(dt);
+    JPH::Vec4 gx = JPH::Vec4::sReplicate(gravity.GetX() * dt);
+    JPH::Vec4 gy = JPH::Vec4::sReplicate(gravity.GetY() * dt);
+    JPH::Vec4 gz = JPH::Vec4::sReplicate(gravity.GetZ() * dt);
+
+    // Los huecos del último grupo también se calculan, pero nadie los lee
+    for(size_t i = 0, end = roundLanes(m_count); i < end; i += Lanes)
+    {
+        JPH::Vec4 vx = load(m_vx, i) + gx;
+        JPH::Vec4 vy = load(m_vy, i) + gy;
+        JPH::Vec4 vz = load(m_vz, i) + gz;
+
+        store(vx, m_vx, i);
+        store(vy, m_vy, i);
+        store(vz, m_vz, i);
+
+        store(vx * step, m_dx, i);
+        store(vy * step, m_dy, i);
+        store(vz * step, m_dz, i);
+
+        store(load(m_life, i) - step, m_life, i);
+    }
+}
+
+void ProjectileSystem::castRays()
+{
+    // Cada lote sólo escribe los resultados de sus índices
+    PhysicsQueries::Get().parallelFor(uint32_t(m_count), uint32_t(m_settings.batch_size), [this](uint32_t begin, uint32_t end) {
+        castRays(begin, end);
+    });
+}
+
+void ProjectileSystem::castRays(size_t begin, size_t end)
+{
+    auto& system = Engine::Physics::Get().GetSystem();
+    const auto& query = system.GetNarrowPhaseQuery();
+
+    for(size_t i = begin; i < end; i++)
+    {
+        m_hit_body[i] = JPH::BodyID();
+
+        JPH::RRayCast ray{JPH::RVec3(m_px[i], m_py[i], m_pz[i]), JPH::Vec3(m_dx[i], m_dy[i], m_dz[i])};
+        JPH::RayCastResult hit;
+        PhysicsQueries::Filter filter(m_layer, m_owner[i], false);
+        auto broadphase_filter = CollisionLayers::Get().MakeBroadPhaseFilter(m_layer);
+        auto layer_filter = CollisionLayers::Get().MakeObjectLayerFilter(m_layer);
+
+        if(!query.CastRay(ray, hit, broadphase_filter, layer_filter, filter))
+            continue;
+
+        JPH::RVec3 point = ray.GetPointOnRay(hit.mFraction);
+        JPH::Vec3 normal = -ray.mDirection.NormalizedOr(JPH::Vec3::sAxisY());
+
+        JPH::BodyLockRead lock(system.GetBodyLockInterface(), hit.mBodyID);
+        if(lock.Succeeded())
+            normal = lock.GetBody().GetWorldSpaceSurfaceNormal(hit.mSubShapeID2, point);
+
+        m_hit_body[i] = hit.mBodyID;
+        m_hit_point[i] = toGlm(JPH::Vec3(point));
+        m_hit_normal[i] = toGlm(normal);
+    }
+}
+
+void ProjectileSystem::advance()
+{
+    for(size_t i = 0, end = roundLanes(m_count); i < end; i += Lanes)
+    {
+        store(load(m_px, i) + load(m_dx, i), m_px, i);
+        store(load(m_py, i) + load(m_dy, i), m_py, i);
+        store(load(m_pz, i) + load(m_dz, i), m_pz, i);
+    }
+}
+
+void ProjectileSystem::retire()
+{
+    for(size_t i = 0; i < m_count;)
+    {
+        if(!m_hit_body[i].IsInvalid())
+        {
+            m_events.push_back({
+                m_hit_body[i],
+                m_owner[i],
+                m_hit_point[i],
+                m_hit_normal[i],
+                {m_vx[i], m_vy[i], m_vz[i]}
+            });
+            remove(i);
+        }else if(m_life[i] <= 0.f)
+            remove(i);
+        else
+            i++;
+    }
+}
+
+void ProjectileSystem::remove(size_t index)
+{
+    size_t last = --m_count;
+    if(index == last)
+        return;
+
+    for(auto* values : {&m_px, &m_py, &m_pz, &m_vx, &m_vy, &m_vz, &m_dx, &m_dy, &m_dz, &m_life})
+        (*values)[index] = (*values)[last];
+
+    m_owner[index] = m_owner[last];
+    m_hit_body[index] = m_hit_body[last];
+    m_hit_point[index] = m_hit_point[last];
+    m_hit_normal[index] = m_hit_normal[last];
+}
+
+void ProjectileSystem::dispatch()
+{
+    if(m_events.empty())
+        return;
+
+    // Un callback puede disparar otra vez: spawn() escribe en los arrays, no aquí
+    std::swap(m_events, m_dispatching);
+    m_hits += m_dispatching.size();
+
+    auto& bodies = Engine::Physics::Get().GetBodyInterface();
+    for(auto& hit : m_dispatching)
+    {
+        if(m_settings.impulse > 0.f && bodies.GetMotionType(hit.body) == JPH::EMotionType::Dynamic)
+        {
+            glm::vec3 impulse = hit.velocity * m_settings.impulse;
+            bodies.AddImpulse(
+                hit.body,
+                JPH::Vec3(impulse.x, impulse.y, impulse.z),
+                JPH::RVec3(hit.point.x, hit.point.y, hit.point.z)
+            );
+        }
+
+        CoroutineScheduler::Get().notifyContact(hit.body);
+
+        if(m_on_hit)
+            m_on_hit(hit);
+    }
+
+    m_dispatching.clear();
+}
+
+
+ProjectileClock::ProjectileClock(std::shared_ptr<ProjectileSystem> projectiles)
+    : projectiles(projectiles)
+{
+}
+
+void ProjectileClock::OnPhysicsUpdate(float dt)
+{
+    if(projectiles)
+        projectiles->update(dt);
+}
+
+
+ProjectileView::ProjectileView(std::shared_ptr<ProjectileSystem> projectiles, std::shared_ptr<ObjectPool> pool)
+    : projectiles(projectiles), pool(pool)
+{
+    if(pool)
+        shown.reserve(pool->getCapacity());
+}
+
+void ProjectileView::OnUpdate(const GLfloat&)
+{
+    if(!projectiles || !pool)
+        return;
+
+    // El orden de los proyectiles cambia al compactar, pero todas las instancias son iguales
+    size_t count = std::min(projectiles->size(), pool->getCapacity());
+
+    while(shown.size() > count)
+    {
+        pool->release(shown.back());
+        shown.pop_back();
+    }
+
+    while(shown.size() < count)
+    {
+        auto obstacle = pool->acquire(projectiles->getPosition(shown.size()));
+        if(!obstacle)
+            break;
+
+        shown.push_back(std::move(obstacle));
+    }
+
+    for(size_t i = 0; i < shown.size(); i++)
+        shown[i]->getObject()->getTransform()->translate(projectiles->getPosition(i));
+}
@@ -0,0 +1,166 @@
+#include <cstring>
+#include <iostream>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+
+#include <GLS/Physics.hpp>
+#include <GLS/TransformComponent.hpp>
+
+#include "BodyIDs.hpp"
+#include "SceneSnapshot.hpp"
+#include "Triggers.hpp"
+
+
+namespace
+{
+    // Se guarda la caché de contactos vacía: al restaurar se descartan los contactos de antes
+    class NoContacts final : public JPH::StateRecorderFilter
+    {
+        public:
+        bool ShouldSaveContact(const JPH::BodyID&, const JPH::BodyID&) const override { return false; }
+    };
+}
+
+
+void SnapshotRecorder::WriteBytes(const void* inData, size_t inNumBytes)
+{
+    auto bytes = static_cast<const uint8_t*>(inData);
+    m_data.insert(m_data.end(), bytes, bytes + inNumBytes);
+}
+
+void SnapshotRecorder::ReadBytes(void* outData, size_t inNumBytes)
+{
+    if(m_cursor + inNumBytes > m_data.size())
+    {
+        m_failed = true;
+        std::memset(outData, 0, inNumBytes);
+        return;
+    }
+
+    std::memcpy(outData, m_data.data() + m_cursor, inNumBytes);
+    m_cursor += inNumBytes;
+}
+
+void SnapshotRecorder::Rewind()
+{
+    m_cursor = 0;
+    m_failed = false;
+}
+
+void SnapshotRecorder::Clear()
+{
+    m_data.clear();
+    Rewind();
+}
+
+
+void SceneSnapshot::track(const std::shared_ptr<Engine::GameObject>& object)
+{
+    if(!object)
+        return;
+
+    Tracked tracked{object, {}};
+
+    for(auto& component : object->getComponents())
+        if(auto state = std::dynamic_pointer_cast<Snapshotable>(component))
+            tracked.states.push_back(state);
+
+    m_objects.push_back(std::move(tracked));
+}
+
+void SceneSnapshot::track(const std::shared_ptr<Snapshotable>& state)
+{
+    if(state)
+        m_systems.push_back(state);
+}
+
+void SceneSnapshot::capture()
+{
+    NoContacts no_contacts;
+    m_physics.Clear();
+    Engine::Physics::Get().GetSystem().SaveState(m_physics, JPH::EStateRecorderState::Contacts, &no_contacts);
+
+    m_state.Clear();
+    for(auto& tracked : m_objects)
+    {
+        SaveObject(tracked.object, m_state);
+        for(auto& state : tracked.states)
+            state->SaveState(m_state);
+    }
+
+    for(auto& state : m_systems)
+        state->SaveState(m_state);
+
+    m_captured = true;
+}
+
+bool SceneSnapshot::restore()
+{
+    if(!m_captured)
+        return false;
+
+    m_physics.Rewind();
+    if(!Engine::Physics::Get().GetSystem().RestoreState(m_physics))
+    {
+        std::cerr << "[SceneSnapshot] no se pudo restaurar el estado fisico" << std::endl;
+        return false;
+    }
+
+    // Los contactos del personaje se vuelven a detectar: un trigger no puede seguir enganchado
+    Triggers::Get().ResetOverlaps();
+
+    m_state.Rewind();
+    for(auto& tracked : m_objects)
+    {
+        RestoreObject(tracked.object, m_state);
+        for(auto& state : tracked.states)
+            state->RestoreState(m_state);
+    }
+
+    for(auto& state : m_systems)
+        state->RestoreState(m_state);
+
+    return !m_state.IsFailed();
+}
+
+void SceneSnapshot::SaveObject(const std::shared_ptr<Engine::GameObject>& object, JPH::StateRecorder& stream)
+{
+    auto transform = object->getTransform();
+    stream.Write(transform->getPosition());
+    stream.Write(transform->getRotation());
+
+    auto body = object->getBody();
+    auto& system = Engine::Physics::Get().GetSystem();
+    JPH::BodyLockRead lock(system.GetBodyLockInterface(), body && body->IsValid() ? BodyIDs::Get().Find(body) : JPH::BodyID());
+
+    stream.Write(lock.Succeeded());
+    if(lock.Succeeded())
+        system.SaveBodyState(lock.GetBody(), stream);
+}
+
+void SceneSnapshot::RestoreObject(const std::shared_ptr<Engine::GameObject>& object, JPH::StateRecorder& stream)
+{
+    glm::vec3 position;
+    glm::quat rotation;
+    stream.Read(position);
+    stream.Read(rotation);
+
+    auto transform = object->getTransform();
+    transform->translate(position);
+    transform->rotate(rotation);
+
+    bool has_body = false;
+    stream.Read(has_body);
+    if(!has_body)
+        return;
+
+    auto body = object->getBody();
+    auto& system = Engine::Physics::Get().GetSystem();
+    JPH::BodyLockWrite lock(system.GetBodyLockInterface(), body ? BodyIDs::Get().Find(body) : JPH::BodyID());
+    if(lock.Succeeded())
+        system.RestoreBodyState(lock.GetBody(), stream);
+    else
+        std::cerr << "[SceneSnapshot] el objeto ya no tiene el cuerpo capturado" << std::endl;
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+
+#include "ScriptRegistry.hpp"
+
+
+ScriptRegistry& ScriptRegistry::Get()
+{
+    static ScriptRegistry instance;
+    return instance;
+}
+
+ScriptId ScriptRegistry::find(const std::string& name) const
+{
+    auto it = m_ids.find(name);
+    return it != m_ids.end() ? it->second : InvalidScript;
+}
+
+const std::string& ScriptRegistry::getName(ScriptId id) const
+{
+    static const std::string empty;
+    return id < m_entries.size() ? m_entries[id].name : empty;
+}
+
+std::shared_ptr<Engine::ScriptComponent> ScriptRegistry::create(ScriptId id, const void* params) const
+{
+    if(id >= m_entries.size())
+        return nullptr;
+
+    return m_entries[id].factory(params);
+}
+
+std::span<const ParamField> ScriptRegistry::getFields(ScriptId id) const
+{
+    return id < m_entries.size() ? m_entries[id].fields : std::span<const ParamField>();
+}
+
+ScriptSpec ScriptRegistry::makeSpec(ScriptId id, std::span<const ParamValue> values) const
+{
+    if(id >= m_entries.size())
+        return {};
+
+    const Entry& entry = m_entries[id];
+    std::shared_ptr<void> params = entry.defaults();
+
+    for(const ParamValue& value : values)
+    {
+        const ParamField* field = nullptr;
+        for(const ParamField& candidate : entry.fields)
+        {
+            if(value.name == candidate.name)
+            {
+                field = &candidate;
+                break;
+            }
+        }
+
+        if(!field)
+        {
+            std::cerr << "[ScriptRegistry] " << entry.name << " no tiene el parámetro '" << value.name << "'" << std::endl;
+            return {};
+        }
+
+        if(!field->accepts(value.type))
+        {
+            std::cerr << "[ScriptRegistry] Tipo incorrecto para " << entry.name << "." << value.name << std::endl;
+            return {};
+        }
+
+        field->write(params.get(), value);
+    }
+
+    return ScriptSpec(id, std::move(params));
+}
+
+ScriptId ScriptRegistry::add(const char* name, Factory factory, Defaults defaults, std::span<const ParamField> fields)
+{
+    auto [it, inserted] = m_ids.emplace(name, ScriptId(m_entries.size()));
+    if(inserted)
+        m_entries.push_back({name, factory, defaults, fields});
+    else if(m_entries[it->second].factory != factory)
+        std::cerr << "[ScriptRegistry] Nombre de script repetido: " << name << std::endl;
+
+    return it->second;
+}
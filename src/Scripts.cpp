@@ -4,103 +4,96 @@
 #include <GLS/Utils.hpp>
 
 #include "Scripts.hpp"
+#include "CharacterController.hpp"
+#include "AudioSystem.hpp"
+#include "Log.hpp"
 
 
-PlataformaMovil::PlataformaMovil(scriptParams params)
+namespace
 {
-    try {
-        this->min = std::get<float>(params[0]);
-        this->max = std::get<float>(params[1]);
-        this->vertical = (std::get<std::string>(params[2]) == "vertical");
-    }catch(const std::exception& e)
-    {
-        std::cout << "Error al crear plataforma movil: " << e.what() << std::endl;
-    }
+    // Log asíncrono y filtrable (GAME_LOG="Enemy=debug")
+    LogCategory log_platform("PlataformaMovil");
+    LogCategory log_enemy("Enemy");
 }
 
 
-void PlataformaMovil::OnPhysicsUpdate(float dt)
+PlataformaMovil::PlataformaMovil() : PlataformaMovil(Params{})
 {
-    auto pos = body->GetPosition();
+}
+
+PlataformaMovil::PlataformaMovil(const Params& params)
+    : vertical(params.vertical), max(params.max), min(params.min)
+{
+}
 
-    float val = 0.f;
 
-    if(vertical)
-        val = pos.GetY();
-    else
-        val = pos.GetX();
+Behaviour PlataformaMovil::run()
+{
+    Axis axis = vertical ? Axis::Y : Axis::X;
+    JPH::Vec3 direction = vertical ? JPH::Vec3(0.f, 1.f, 0.f) : JPH::Vec3(1.f, 0.f, 0.f);
 
-    std::cout << "[PlataformaMovil] valor: " << val << std::endl;
+    // Empieza subiendo salvo que ya esté en el extremo superior
+    auto pos = body->GetPosition();
+    bool up = (vertical ? pos.GetY() : pos.GetX()) < max;
 
-    if(val <= min)
+    // Entre extremo y extremo la corrutina está dormida en el planificador
+    for(;;)
     {
-        std::cout << "[PlataformaMovil] subiendo" << std::endl;
-        if(vertical)
-            body->SetVelocity({0.f, 1.f, 0.f});
-        else
-            body->SetVelocity({1.f, 0.f, 0.f});
-    }else if(val >= max)
-    {
-        std::cout << "[PlataformaMovil] bajando" << std::endl;
-        if(vertical)
-            body->SetVelocity({0.f, -1.f, 0.f});
-        else
-            body->SetVelocity({-1.f, 0.f, 0.f});
-  
+        LOG_DEBUG(log_platform, up ? "subiendo" : "bajando");
+        body->SetVelocity(up ? direction : -direction);
+
+        co_await wait_until_position(body, axis, up ? max : min);
+        up = !up;
     }
 }
 
 
-Enemy::Enemy(scriptParams params)
+Enemy::Enemy() : Enemy(Params{})
+{
+}
+
+Enemy::Enemy(const Params& params)
+    : speed(params.speed), max(params.max), min(params.min)
 {
     rot_left = Engine::Utils::toQuant({0.f, 1.f, 0.f}, 90.f);
     rot_right = Engine::Utils::toQuant({0.f, 1.f, 0.f}, -90.f);
-
-    try {
-        this->min = std::get<float>(params[0]);
-        this->max = std::get<float>(params[1]);
-        this->speed = std::get<float>(params[2]);
-    }catch(const std::exception& e)
-    {
-        std::cout << "Error al crear enemy: " << e.what() << std::endl;
-    }
 }
 
-void Enemy::OnPhysicsUpdate(float dt)
+Behaviour Enemy::run()
 {
-    float x_pos = body->GetPosition().GetX();
-    std::cout << "[Enemy] pos: " << x_pos << std::endl;
-    if(x_pos <= min)
-    {
-        body->SetVelocity({speed, 0.f, 0.f});
-        body->SetRotation(rot_left);
-    }else if(x_pos >= max)
+    bool right = body->GetPosition().GetX() < max;
+
+    for(;;)
     {
-        body->SetVelocity({-speed, 0.f, 0.f});
-        body->SetRotation(rot_right);
+        LOG_DEBUG(log_enemy, "pos:", float(body->GetPosition().GetX()));
+        body->SetVelocity({right ? speed : -speed, 0.f, 0.f});
+        body->SetRotation(right ? rot_left : rot_right);
+
+        co_await wait_until_position(body, Axis::X, right ? max : min);
+        right = !right;
     }
 }
 
 
-Parachute::Parachute(scriptParams params)
+Parachute::Parachute(const Params& params)
+    : is_coll(params.is_coll), input(params.input)
 {
-    try {
-        this->is_coll = std::get<bool*>(params[0]);
-        this->input = std::get<inputManager*>(params[1]);
-        this->user = std::get<Engine::GameObject*>(params[2]);
-    }catch(const std::exception& e)
-    {
-        std::cerr << "Error al crear parachute: " << e.what() << std::endl;
-    }
+    if(!is_coll || !input)
+        std::cerr << "[Parachute] Faltan is_coll o input, el script no hará nada" << std::endl;
 }
 
-void Parachute::OnPhysicsUpdate(float dt)
+void Parachute::OnLODPhysicsUpdate(float)
 {
+    // is_coll es compartido: uno descargado no debe engancharse al jugador
+    if(!is_coll || !input || streamed_out)
+        return;
+
+    auto& character = input->getCharacter();
 
-    if(hooked && input->is_holding())
+    if(hooked && input->is_holding() && character)
     {
-        user->getBody()->SetPosition(Engine::Utils::toGLMVec3(body->GetPosition()) + offset);
-        user->getBody()->SetVelocity({0.f, 0.f, 0.f});
+        character->setPosition(Engine::Utils::toGLMVec3(body->GetPosition()) + offset);
+        character->setLinearVelocity({0.f, 0.f, 0.f});
         body->SetVelocity(input->getForward() * speed);
         return;
     }else if(!input->is_holding())
@@ -112,4 +105,59 @@ void Parachute::OnPhysicsUpdate(float dt)
         hooked = true;
     }
 
-}
\ No newline at end of file
+    setLODActive(hooked);
+
+}
+
+void Parachute::SaveState(JPH::StateRecorder& stream) const
+{
+    stream.Write(hooked);
+}
+
+void Parachute::RestoreState(JPH::StateRecorder& stream)
+{
+    stream.Read(hooked);
+    setLODActive(hooked && !streamed_out);
+
+    // Triggers olvida el solapamiento al restaurar: el contacto se vuelve a notificar
+    if(is_coll)
+        *is_coll = false;
+}
+
+void Parachute::OnStreamIn()
+{
+    streamed_out = false;
+}
+
+void Parachute::OnStreamOut()
+{
+    streamed_out = true;
+    hooked = false;
+    setLODActive(false);
+}
+
+
+AudioListener::AudioListener(std::shared_ptr<Engine::CameraComponent> camera)
+    : camera(camera)
+{
+
+}
+
+void AudioListener::OnUpdate(const GLfloat& dt)
+{
+    auto& audio = AudioSystem::Get();
+
+    audio.setListenerPosition(getOwner()->getTransform()->getPosition());
+    if(camera)
+        audio.setListenerDirection(camera->getForward());
+
+    audio.update(dt);
+}
+
+
+void RegisterScripts()
+{
+    ScriptRegistry::id<PlataformaMovil>();
+    ScriptRegistry::id<Enemy>();
+    ScriptRegistry::id<Parachute>();
+}
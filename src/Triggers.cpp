@@ -0,0 +1,217 @@
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+
+#include <GLS/Physics.hpp>
+
+#include "BodyIDs.hpp"
+#include "Triggers.hpp"
+
+
+Triggers& Triggers::Get()
+{
+    static Triggers instance;
+    return instance;
+}
+
+void Triggers::attachContacts()
+{
+    if(m_attached || !Engine::Physics::IsInitialized())
+        return;
+
+    auto& system = Engine::Physics::Get().GetSystem();
+    m_next = system.GetContactListener();
+    system.SetContactListener(this);
+    m_attached = true;
+}
+
+void Triggers::dispatch()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_contacts_mutex);
+        if(m_contacts.empty())
+            return;
+        std::swap(m_contacts, m_dispatching);
+    }
+
+    // Un callback puede añadir o quitar triggers: se cuenta todo antes de llamar
+    std::vector<Callback> callbacks;
+    for(const auto& contact : m_dispatching)
+    {
+        Callback callback;
+        if(contact.enter)
+            Enter(contact.id, callback);
+        else
+            Exit(contact.id, callback);
+
+        if(callback)
+            callbacks.push_back(std::move(callback));
+    }
+    m_dispatching.clear();
+
+    for(auto& callback : callbacks)
+        callback();
+}
+
+void Triggers::Add(const std::shared_ptr<Engine::Body>& body, Callback onEnter, Callback onExit)
+{
+    if(!body || !body->IsValid())
+        return;
+
+    JPH::BodyID id = BodyIDs::Get().Find(body);
+    Engine::Physics::Get().GetBodyInterface().SetIsSensor(id, true);
+
+    if(Trigger* trigger = find(id))
+    {
+        trigger->on_enter = onEnter;
+        trigger->on_exit = onExit;
+        return;
+    }
+
+    uint32_t slot;
+    if(!m_free.empty())
+    {
+        slot = m_free.back();
+        m_free.pop_back();
+        m_triggers[slot] = {id, onEnter, onExit, 0};
+    }else
+    {
+        slot = static_cast<uint32_t>(m_triggers.size());
+        m_triggers.push_back({id, onEnter, onExit, 0});
+    }
+
+    uint32_t index = id.GetIndex();
+    if(index >= m_slots.size())
+        m_slots.resize(index + 1, NoSlot);
+
+    m_slots[index] = slot;
+}
+
+void Triggers::Remove(JPH::BodyID id)
+{
+    if(find(id) == nullptr)
+        return;
+
+    uint32_t slot = m_slots[id.GetIndex()];
+    m_triggers[slot] = {};
+    m_free.push_back(slot);
+    m_slots[id.GetIndex()] = NoSlot;
+}
+
+bool Triggers::IsTrigger(JPH::BodyID id) const
+{
+    return find(id) != nullptr;
+}
+
+bool Triggers::Enter(JPH::BodyID id, Callback& outCallback)
+{
+    Trigger* trigger = find(id);
+    if(trigger == nullptr)
+        return false;
+
+    if(trigger->overlaps++ == 0)
+        outCallback = trigger->on_enter;
+
+    return true;
+}
+
+bool Triggers::Exit(JPH::BodyID id, Callback& outCallback)
+{
+    Trigger* trigger = find(id);
+    if(trigger == nullptr)
+        return false;
+
+    if(trigger->overlaps > 0 && --trigger->overlaps == 0)
+        outCallback = trigger->on_exit;
+
+    return true;
+}
+
+void Triggers::ResetOverlaps()
+{
+    for(auto& trigger : m_triggers)
+        trigger.overlaps = 0;
+
+    std::lock_guard<std::mutex> lock(m_contacts_mutex);
+    m_contacts.clear();
+}
+
+void Triggers::notify(JPH::BodyID id, bool enter)
+{
+    if(!IsTrigger(id))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_contacts_mutex);
+    m_contacts.push_back({id, enter});
+}
+
+JPH::ValidateResult Triggers::OnContactValidate(
+    const JPH::Body& inBody1,
+    const JPH::Body& inBody2,
+    JPH::RVec3Arg inBaseOffset,
+    const JPH::CollideShapeResult& inCollisionResult)
+{
+    if(m_next)
+        return m_next->OnContactValidate(inBody1, inBody2, inBaseOffset, inCollisionResult);
+
+    return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
+}
+
+void Triggers::OnContactAdded(
+    const JPH::Body& inBody1,
+    const JPH::Body& inBody2,
+    const JPH::ContactManifold& inManifold,
+    JPH::ContactSettings& ioSettings)
+{
+    // Jolt avisa una vez por par de subformas; Enter/Exit ya cuentan solapamientos
+    if(inBody1.IsSensor())
+        notify(inBody1.GetID(), true);
+    if(inBody2.IsSensor())
+        notify(inBody2.GetID(), true);
+
+    if(m_next)
+        m_next->OnContactAdded(inBody1, inBody2, inManifold, ioSettings);
+}
+
+void Triggers::OnContactPersisted(
+    const JPH::Body& inBody1,
+    const JPH::Body& inBody2,
+    const JPH::ContactManifold& inManifold,
+    JPH::ContactSettings& ioSettings)
+{
+    if(m_next)
+        m_next->OnContactPersisted(inBody1, inBody2, inManifold, ioSettings);
+}
+
+void Triggers::OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair)
+{
+    // Aquí no se pueden leer los cuerpos: basta con la tabla de triggers
+    notify(inSubShapePair.GetBody1ID(), false);
+    notify(inSubShapePair.GetBody2ID(), false);
+
+    if(m_next)
+        m_next->OnContactRemoved(inSubShapePair);
+}
+
+Triggers::Trigger* Triggers::find(JPH::BodyID id)
+{
+    return const_cast<Trigger*>(static_cast<const Triggers*>(this)->find(id));
+}
+
+const Triggers::Trigger* Triggers::find(JPH::BodyID id) const
+{
+    uint32_t index = id.GetIndex();
+    if(id.IsInvalid() || index >= m_slots.size() || m_slots[index] == NoSlot)
+        return nullptr;
+
+    const Trigger& trigger = m_triggers[m_slots[index]];
+
+    // El índice se reutiliza cuando Jolt recicla un cuerpo: comprobar la secuencia
+    return trigger.id == id ? &trigger : nullptr;
+}
+
+
+void TriggerClock::OnPhysicsUpdate(float)
+{
+    Triggers::Get().dispatch();
+}
@@ -0,0 +1,38 @@
+#include "UIDataModel.hpp"
+
+
+UIDataModel::UIDataModel(Rml::Context* context, const std::string& name)
+    : m_name(name)
+{
+    if(!context)
+    {
+        std::cerr << "[UIDataModel] Contexto nulo para el modelo '" << name << "'" << std::endl;
+        return;
+    }
+
+    m_constructor = context->CreateDataModel(name);
+    if(!m_constructor)
+    {
+        std::cerr << "[UIDataModel] No se pudo crear el modelo '" << name << "'" << std::endl;
+        return;
+    }
+
+    m_handle = m_constructor.GetModelHandle();
+    m_valid = true;
+}
+
+void UIDataModel::dirtyAll()
+{
+    if(!m_valid)
+        return;
+
+    m_handle.DirtyAllVariables();
+    m_changed = true;
+}
+
+bool UIDataModel::consumeChanges()
+{
+    bool changed = m_changed;
+    m_changed = false;
+    return changed;
+}
@@ -0,0 +1,69 @@
+#include "UIDataModel.hpp"
+#include "UILayer.hpp"
+
+
+UILayer::UILayer(std::shared_ptr<UIManager> ui_manager, std::shared_ptr<Engine::Renderer> renderer)
+    : m_ui_manager(ui_manager), m_renderer(renderer)
+{
+}
+
+bool UILayer::show(const std::string& template_id)
+{
+    if(!m_ui_manager->ShowTemplate(template_id))
+        return false;
+
+    m_changed |= m_visible.insert(template_id).second;
+    sync();
+    return true;
+}
+
+bool UILayer::hide(const std::string& template_id)
+{
+    if(!m_ui_manager->HideTemplate(template_id))
+        return false;
+
+    m_changed |= m_visible.erase(template_id) != 0;
+    sync();
+    return true;
+}
+
+bool UILayer::isVisible(const std::string& template_id) const
+{
+    return m_visible.count(template_id) != 0;
+}
+
+void UILayer::watch(UIDataModel* model)
+{
+    if(model)
+        m_models.push_back(model);
+}
+
+bool UILayer::consumeChanges()
+{
+    bool changed = m_changed;
+    m_changed = false;
+
+    for(auto* model : m_models)
+        changed |= model->consumeChanges();
+
+    // Lo que cambie sin nada en pantalla no se ve
+    return changed && !m_visible.empty();
+}
+
+void UILayer::detach()
+{
+    // El modelo se destruye con el shutdown de la UI
+    m_models.clear();
+    m_detached = true;
+    sync();
+}
+
+void UILayer::sync()
+{
+    bool attach = !m_detached && !m_visible.empty();
+    if(attach == m_attached)
+        return;
+
+    m_renderer->setUIManager(attach ? m_ui_manager : nullptr);
+    m_attached = attach;
+}
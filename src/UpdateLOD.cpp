@@ -0,0 +1,121 @@
+#include <algorithm>
+
+#include <GLS/GameObject.hpp>
+#include <GLS/TransformComponent.hpp>
+
+#include "UpdateLOD.hpp"
+
+
+// --- UpdateLOD ---
+
+UpdateLOD& UpdateLOD::Get()
+{
+    static UpdateLOD instance;
+    return instance;
+}
+
+void UpdateLOD::setViewer(const glm::mat4& view, const glm::mat4& projection)
+{
+    m_viewer = glm::vec3(glm::inverse(view)[3]);
+
+    // Planos del frustum a partir de la matriz de vista-proyección (Gribb-Hartmann)
+    glm::mat4 m = glm::transpose(projection * view);
+    m_planes[0] = m[3] + m[0];
+    m_planes[1] = m[3] - m[0];
+    m_planes[2] = m[3] + m[1];
+    m_planes[3] = m[3] - m[1];
+    m_planes[4] = m[3] + m[2];
+    m_planes[5] = m[3] - m[2];
+
+    for(auto& plane : m_planes)
+        plane /= glm::length(glm::vec3(plane));
+
+    m_has_viewer = true;
+    m_frame++;
+
+    m_last_ticked = m_ticked;
+    m_last_skipped = m_skipped;
+    m_ticked = m_skipped = 0;
+}
+
+unsigned UpdateLOD::interval(const glm::vec3& position, const LODPolicy& policy) const
+{
+    if(!m_has_viewer)
+        return 1;
+
+    for(const auto& plane : m_planes)
+    {
+        if(glm::dot(glm::vec3(plane), position) + plane.w < -policy.radius)
+            return policy.hidden_interval;
+    }
+
+    float distance = glm::length(position - m_viewer);
+    if(distance <= policy.near_distance)
+        return 1;
+    if(distance <= policy.far_distance)
+        return std::max(1u, policy.mid_interval);
+
+    return std::max(1u, policy.far_interval);
+}
+
+
+// --- LODScript ---
+
+LODScript::LODScript()
+{
+    // Fase repartida entre instancias para no actualizar todas en el mismo frame
+    static unsigned next_phase = 0;
+    m_phase = next_phase++;
+}
+
+void LODScript::refresh()
+{
+    auto& lod = UpdateLOD::Get();
+    if(m_frame == lod.getFrame())
+        return;
+
+    m_frame = lod.getFrame();
+
+    auto owner = getOwner();
+    m_interval = (owner && !m_active) ? lod.interval(owner->getTransform()->getPosition(), m_policy) : 1;
+    m_tick = m_interval != 0 && (m_frame + m_phase) % m_interval == 0;
+    lod.count(m_tick);
+}
+
+void LODScript::OnUpdate(const GLfloat& dt)
+{
+    refresh();
+
+    m_update_dt = std::min(m_update_dt + dt, MaxAccumulated);
+    if(!m_tick)
+        return;
+
+    OnLODUpdate(m_update_dt);
+    m_update_dt = 0.f;
+}
+
+void LODScript::OnPhysicsUpdate(float dt)
+{
+    refresh();
+
+    m_physics_dt = std::min(m_physics_dt + dt, MaxAccumulated);
+    if(!m_tick)
+        return;
+
+    OnLODPhysicsUpdate(m_physics_dt);
+    m_physics_dt = 0.f;
+}
+
+
+// --- UpdateLODClock ---
+
+UpdateLODClock::UpdateLODClock(std::shared_ptr<Engine::CameraComponent> camera)
+    : camera(camera)
+{
+}
+
+void UpdateLODClock::OnUpdate(const GLfloat&)
+{
+    if(camera)
+        UpdateLOD::Get().setViewer(camera->getViewMatrix(), camera->getProjectionMatrix());
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>       // Si usas cout
 
 #include <GLS/TransformComponent.hpp> // Necesario para getTransform()
@@ -10,10 +11,32 @@
 #include <GLS/Utils.hpp>
 
 #include "inputManager.hpp"
+#include "CharacterController.hpp"
+#include "FramePacer.hpp"
+#include "InputQueue.hpp"
+#include "Log.hpp"
 
 
 using namespace Engine;
 
+namespace
+{
+    LogCategory log_input("InputManager");
+
+    // Bit de cada tecla de movimiento en move_keys
+    uint8_t moveBit(int key)
+    {
+        switch(key)
+        {
+            case GLFW_KEY_W: return 1 << 0;
+            case GLFW_KEY_S: return 1 << 1;
+            case GLFW_KEY_D: return 1 << 2;
+            case GLFW_KEY_A: return 1 << 3;
+            default: return 0;
+        }
+    }
+}
+
 inputManager::inputManager(const bool& paused) : Input(), paused(paused)
 {
     // Inicialización del generador aleatorio
@@ -48,48 +71,107 @@ void inputManager::update(const float &dt) noexcept
     handlePauseInput();
 
     if(paused)
-        return;
-
-    // 1. --- Lógica del Salto del Jugador (Y) ---
-    if (is_key_pressed(GLFW_KEY_SPACE) && !is_jumping)
     {
-        if (auto body = user->getBody()) {
-            body->ApplyImpulse({0.f, 1800.f, 0.f});
-            is_jumping = true;
+        // En menús no hace falta dibujar sin parar: esperar a input o al siguiente frame
+        if(pacer)
+        {
+            if(!was_paused)
+                pacer->reset();
+            pacer->idle();
         }
-    }
-
-    if(is_mouse_button_pressed(GLFW_MOUSE_BUTTON_LEFT))
-    {
-        holing = true;
-    }else if(holing)
-    {
+        // Lo pulsado en los menús no debe llegar al juego al reanudar. Las
+        // sueltas también se descartan, así que nada puede quedar pulsado
+        InputQueue::Get().clear();
         holing = false;
+        jump_held = false;
+        move_keys = 0;
+        sim_time = 0.0;
+        was_paused = true;
+        return;
     }
+    was_paused = false;
 
-
+    // Movimiento, salto y paracaídas se leen de la cola en step(), con el paso fijo del personaje
     handle_camera(dt);
 
-    handle_move();
-
     gameOver();
     
 }
 
-void inputManager::handle_camera(const float &dt) noexcept
+void inputManager::step(float dt) noexcept
+{
+    if(paused)
+        return;
+
+    // Reloj de simulación: avanza un paso fijo cada vez, sin adelantarse al real
+    double now = glfwGetTime();
+    if(sim_time == 0.0 || now - sim_time > 0.25)
+        sim_time = now - dt;
+    sim_time = std::min(sim_time + dt, now);
+
+    bool jump_pressed = false;
+    InputQueue::Get().consume(sim_time, [&](const InputEvent& event) {
+        if(event.action == GLFW_REPEAT)
+            return;
+
+        bool pressed = event.action == GLFW_PRESS;
+        if(pressed && onInputConsumed)
+            onInputConsumed(event.time);
+
+        if(event.type == InputEvent::Type::Key && event.code == GLFW_KEY_SPACE)
+        {
+            jump_pressed |= pressed;
+            jump_held = pressed;
+        }
+        else if(event.type == InputEvent::Type::Key && moveBit(event.code))
+        {
+            if(pressed)
+                move_keys |= moveBit(event.code);
+            else
+                move_keys &= ~moveBit(event.code);
+        }
+        else if(event.type == InputEvent::Type::MouseButton && event.code == GLFW_MOUSE_BUTTON_LEFT)
+        {
+            holing = pressed;
+        }
+        else if(event.type == InputEvent::Type::MouseButton && event.code == GLFW_MOUSE_BUTTON_RIGHT)
+        {
+            if(pressed && onFire)
+                onFire();
+        }
+    });
+
+    // Una pulsación más corta que un frame también salta; mantener sigue saltando al aterrizar
+    if((jump_pressed || jump_held) && character)
+        character->jump();
+
+    handle_move();
+}
+
+void inputManager::handle_camera(const float&) noexcept
 {
-    MousePair mouse = get_mouse_delta();
-    if (mouse.x != 0.f || mouse.y != 0.f)
+    // Todo el movimiento desde el último frame, leído justo antes de dibujar. El
+    // desplazamiento ya es por frame, así que no se escala con dt (ref. 60 fps)
+    constexpr float reference_dt = 1.f / 60.f;
+
+    double dx = 0.0, dy = 0.0;
+    InputQueue::Get().takeMouseDelta(dx, dy);
+    if (dx != 0.0 || dy != 0.0)
     {
         if (auto cam = scene->getCamera()) {
-            cam->rotate(mouse.x * sensitivity * 1000 * dt, mouse.y * sensitivity * 1000 * dt);
+            cam->rotate(float(dx) * sensitivity * 1000 * reference_dt, float(dy) * sensitivity * 1000 * reference_dt);
         }
     }
 }
 
-void inputManager::setJumping(bool jumping) noexcept
+void inputManager::setCharacter(std::shared_ptr<CharacterController> controller) noexcept
+{
+    character = controller;
+}
+
+const std::shared_ptr<CharacterController>& inputManager::getCharacter() const noexcept
 {
-    is_jumping = jumping;
+    return character;
 }
 
 const bool & inputManager::is_holding() const noexcept
@@ -114,6 +196,16 @@ void inputManager::gameOver() noexcept
     }
 }
 
+void inputManager::setOnInputConsumed(std::function<void(double)> callback) noexcept
+{
+    onInputConsumed = callback;
+}
+
+void inputManager::setFramePacer(std::shared_ptr<FramePacer> frame_pacer) noexcept
+{
+    pacer = frame_pacer;
+}
+
 void inputManager::setOnGameOver(Engine::Listener::Callback callback) noexcept
 {
     onGameOver = callback;
@@ -138,7 +230,7 @@ void inputManager::handlePauseInput() noexcept
 
 void inputManager::handle_move() noexcept
 {
-    if (auto body = user->getBody()) {
+    if (character) {
         
         auto camera = scene->getCamera();
         if (camera) {
@@ -147,33 +239,37 @@ void inputManager::handle_move() noexcept
             glm::vec3 camForward = camera->getForward(); // Necesitas este vector
             glm::vec3 camRight   = camera->getRight();   // Y este vector
 
-            std::cout << "[InputManager] camForward: " << Utils::toJoltVec3(camForward) << std::endl;
-            std::cout << "[InputManager] camRight: " << Utils::toJoltVec3(camRight) << std::endl;
+            LOG_TRACE(log_input, "camForward:", Utils::toJoltVec3(camForward));
+            LOG_TRACE(log_input, "camRight:", Utils::toJoltVec3(camRight));
 
 
-            glm::vec3 impulse = glm::vec3(0.f, 0.f, 0.f);
+            glm::vec3 direction = glm::vec3(0.f, 0.f, 0.f);
             
 
-            camForward = glm::normalize(camForward);
-            camRight   = glm::normalize(camRight);
+            // Sólo el plano XZ: la cámara mira hacia abajo y no debe frenar al personaje
+            camForward = glm::normalize(glm::vec3(camForward.x, 0.f, camForward.z));
+            camRight   = glm::normalize(glm::vec3(camRight.x, 0.f, camRight.z));
 
 
-            if(is_key_pressed(GLFW_KEY_W)) {
-                impulse += camForward * impulseMagnitude;
-                std::cout << "[InputManager] impulse: " << Utils::toJoltVec3(impulse) << std::endl;
+            if(move_keys & moveBit(GLFW_KEY_W)) {
+                direction += camForward;
+                LOG_TRACE(log_input, "direction:", Utils::toJoltVec3(direction));
             }   
-            if(is_key_pressed(GLFW_KEY_S)) {
-                impulse -= camForward * impulseMagnitude;
+            if(move_keys & moveBit(GLFW_KEY_S)) {
+                direction -= camForward;
             }
             // Verifica si en tu motor Right es + o - según tu sistema de coordenadas
-            if(is_key_pressed(GLFW_KEY_D)) { 
-                impulse += camRight * impulseMagnitude;
+            if(move_keys & moveBit(GLFW_KEY_D)) { 
+                direction += camRight;
             }
-            if(is_key_pressed(GLFW_KEY_A)) {
-                 impulse -= camRight * impulseMagnitude;
+            if(move_keys & moveBit(GLFW_KEY_A)) {
+                 direction -= camRight;
             }
+
+            if(glm::length(direction) > 0.f)
+                direction = glm::normalize(direction);
                                                
-            body->ApplyImpulse({impulse.x, 0.f, impulse.z});
+            character->setMoveDirection(direction);
             
         }
     }
@@ -183,4 +279,9 @@ void inputManager::handle_move() noexcept
 void inputManager::setOnPause(Engine::Listener::Callback callback) noexcept
 {
     onPause = callback;
+}
+
+void inputManager::setOnFire(Engine::Listener::Callback callback) noexcept
+{
+    onFire = callback;
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "LevelCompiler.hpp"
+#include "LevelFile.hpp"
+
+// Convierte niveles de texto a binario (LevelFormat).
+// Uso: LevelCompiler <nivel.txt> <nivel.lvl>
+int main(int argc, char** argv)
+{
+    if(argc != 3)
+    {
+        std::cerr << "Uso: " << argv[0] << " <nivel.txt> <nivel.lvl>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    LevelCompiler compiler;
+    if(!compiler.compile(argv[1], argv[2]))
+        return EXIT_FAILURE;
+
+    // Comprueba que el binario se puede mapear y mide cuánto tarda
+    auto start = std::chrono::steady_clock::now();
+
+    LevelFile file;
+    if(!file.open(argv[2]))
+        return EXIT_FAILURE;
+
+    size_t placements = file.placements().size();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << argv[2] << ": " << placements << " colocaciones, " << file.prefabs().size()
+              << " prefabs, " << file.scripts().size() << " scripts (abierto en " << ms << " ms)" << std::endl;
+
+    return EXIT_SUCCESS;
+}